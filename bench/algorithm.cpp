@@ -0,0 +1,74 @@
+// Median and sort of 5, 7 and 9 element quantity arrays with the sorting networks compared to std::nth_element and
+// std::sort. The inputs are random so that the branches in the std algorithms are unpredictable, as they would be for
+// noisy sensor samples.
+
+#include "bench.hpp"
+#include "ctd/algorithm.hpp"
+#include "ctd/units.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    using sample = ctd::voltage<int16_t, ctd::milli>;
+
+    constexpr size_t windows = 4096;
+
+    template <size_t N>
+    std::vector<sample> random_samples() {
+        std::mt19937 rng(N);
+        std::vector<sample> s(windows * N);
+        for (auto& x : s) {
+            x = sample(static_cast<int16_t>(rng() % 4096));
+        }
+        return s;
+    }
+
+    template <size_t N>
+    void run() {
+        const std::vector<sample> input = random_samples<N>();
+        char name[64];
+        size_t w = 0;
+
+        std::snprintf(name, sizeof(name), "median<%zu> (network)", N);
+        bench::report(name, bench::ns_per_call([&] {
+            bench::do_not_optimize(ctd::median<N>(&input[w * N]));
+            w = (w + 1) % windows;
+        }, 2000000), "ns");
+
+        std::snprintf(name, sizeof(name), "median of %zu (std::nth_element)", N);
+        bench::report(name, bench::ns_per_call([&] {
+            sample copy[N];
+            std::copy_n(&input[w * N], N, copy);
+            std::nth_element(copy, copy + N / 2, copy + N);
+            bench::do_not_optimize(copy[N / 2]);
+            w = (w + 1) % windows;
+        }, 2000000), "ns");
+
+        std::snprintf(name, sizeof(name), "static_sort<%zu>", N);
+        bench::report(name, bench::ns_per_call([&] {
+            sample copy[N];
+            std::copy_n(&input[w * N], N, copy);
+            ctd::static_sort(copy);
+            bench::do_not_optimize(copy);
+            w = (w + 1) % windows;
+        }, 2000000), "ns");
+
+        std::snprintf(name, sizeof(name), "sort of %zu (std::sort)", N);
+        bench::report(name, bench::ns_per_call([&] {
+            sample copy[N];
+            std::copy_n(&input[w * N], N, copy);
+            std::sort(copy, copy + N);
+            bench::do_not_optimize(copy);
+            w = (w + 1) % windows;
+        }, 2000000), "ns");
+    }
+}  // namespace
+
+int main() {
+    run<5>();
+    run<7>();
+    run<9>();
+}
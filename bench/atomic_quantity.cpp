@@ -0,0 +1,97 @@
+// Contention on a shared counter and a shared reading: atomic_quantity compared to a mutex protected quantity. Each
+// thread adds milliampere-second samples to a microcoulomb total, or stores and loads a bus voltage.
+
+#include "bench.hpp"
+#include "ctd/atomic_quantity.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    using charge = ctd::quantity<int64_t, ctd::units::coulomb, ctd::micro>;
+    using sample = ctd::quantity<int32_t, ctd::units::coulomb, ctd::milli>;
+    using bus_voltage = ctd::voltage<int32_t, ctd::milli>;
+
+    constexpr size_t operations = 4000000;
+
+    template <typename Q>
+    class mutex_quantity {
+    public:
+        explicit mutex_quantity(Q q) : v(q) {}
+
+        Q load() const {
+            std::lock_guard<std::mutex> lock(m);
+            return v;
+        }
+
+        void store(Q q) {
+            std::lock_guard<std::mutex> lock(m);
+            v = q;
+        }
+
+        template <typename Other>
+        Q fetch_add(const Other& arg) {
+            std::lock_guard<std::mutex> lock(m);
+            const Q old = v;
+            v = old + Q(arg);
+            return old;
+        }
+
+    private:
+        mutable std::mutex m;
+        Q v;
+    };
+
+    // Returns the mean time in nanoseconds per operation with 'threads' threads sharing 'operations' operations.
+    template <typename F>
+    double contended(size_t threads, F&& f) {
+        std::vector<std::thread> pool;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                for (size_t i = t; i < operations; i += threads) {
+                    f(i);
+                }
+            });
+        }
+        for (auto& t : pool) {
+            t.join();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / operations;
+    }
+
+    template <typename Counter, typename Reading>
+    void run(const char* name, size_t threads) {
+        char label[64];
+        Counter total(charge(0));
+        std::snprintf(label, sizeof(label), "%s fetch_add, %zu threads", name, threads);
+        bench::report(label, contended(threads, [&](size_t i) {
+            total.fetch_add(sample(static_cast<int32_t>(i & 7)));
+        }), "ns/op");
+        bench::do_not_optimize(total.load());
+
+        Reading reading(bus_voltage(12000));
+        std::snprintf(label, sizeof(label), "%s load/store, %zu threads", name, threads);
+        bench::report(label, contended(threads, [&](size_t i) {
+            if (i & 1) {
+                reading.store(bus_voltage(static_cast<int32_t>(i)));
+            }
+            else {
+                bench::do_not_optimize(reading.load());
+            }
+        }), "ns/op");
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t max_threads = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run<ctd::atomic_quantity<charge>, ctd::atomic_quantity<bus_voltage>>("atomic_quantity", threads);
+        run<mutex_quantity<charge>, mutex_quantity<bus_voltage>>("mutex quantity", threads);
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+* Minimal helpers for the host benchmarks. Each benchmark is a separate executable that prints one line per
+* measurement. Build with CMAKE_BUILD_TYPE=Release for meaningful numbers.
+*/
+#ifndef CTD_BENCH_HPP
+#define CTD_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace bench {
+    // Prevents the compiler from optimizing away the computation of 'value'.
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+    // Calls f() 'iterations' times and returns the mean time per call in nanoseconds. The best of 'repeats' runs
+    // is used to filter out noise from the rest of the system.
+    template <typename F>
+    double ns_per_call(F&& f, size_t iterations, int repeats = 5) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < iterations; ++i) {
+                f();
+            }
+            auto end = std::chrono::steady_clock::now();
+            double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+            best = ns < best ? ns : best;
+        }
+        return best;
+    }
+
+    inline void report(const char* name, double value, const char* unit) {
+        std::printf("%-48s %14.3f %s\n", name, value, unit);
+    }
+}  // namespace bench
+
+#endif
@@ -0,0 +1,50 @@
+// Evaluation of a second order PT100 calibration curve with calibration_polynomial, with 64 and 32 bit
+// accumulators, compared to the usual evaluation in double with the rescaling done at run time.
+
+#include "bench.hpp"
+#include "ctd/calibration.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+    using ohm_per_kelvin = ctd::units::detail::unit_powers_subtract<ctd::units::ohm, ctd::units::kelvin>;
+    using ohm_per_kelvin2 = ctd::units::detail::unit_powers_subtract<ohm_per_kelvin, ctd::units::kelvin>;
+    using c0 = ctd::coefficient<100, ctd::units::ohm>;
+    using c1 = ctd::coefficient<39083, ohm_per_kelvin, ctd::ratio<1, 100000>>;
+    using c2 = ctd::coefficient<-5775, ohm_per_kelvin2, ctd::ratio<1, 100000000>>;
+
+    using input = ctd::temperature<int16_t, ctd::centi>;
+    using output = ctd::resistance<int32_t, ctd::milli>;
+
+    constexpr size_t samples = 1 << 12;
+
+    template <typename F>
+    void run(const char* name, const std::vector<input>& in, F&& f) {
+        size_t i = 0;
+        bench::report(name, bench::ns_per_call([&] {
+            bench::do_not_optimize(f(in[i]));
+            i = (i + 1) % samples;
+        }, 20000000), "ns");
+    }
+}  // namespace
+
+int main() {
+    std::mt19937 rng(7);
+    std::vector<input> in(samples);
+    for (auto& x : in) {
+        x = input(static_cast<int16_t>(rng() % 20000 - 5000));
+    }
+
+    run("calibration_polynomial<int64_t>", in, [](input x) {
+        return ctd::calibration_polynomial<input, output, c0, c1, c2>::evaluate(x);
+    });
+    run("calibration_polynomial<int32_t>", in, [](input x) {
+        return ctd::basic_calibration_polynomial<input, output, int32_t, c0, c1, c2>::evaluate(x);
+    });
+    run("double", in, [](input x) {
+        const double t = x.count() * 0.01;
+        const double r = 100.0 + t * (0.39083 + t * -5.775e-5);
+        return output(static_cast<int32_t>(r * 1000.0 + (r < 0 ? -0.5 : 0.5)));
+    });
+}
@@ -0,0 +1,87 @@
+// Size and scan speed of a logged channel stored with column_codec, compared to raw counts and, when zlib is found,
+// to a deflated archive of the raw counts.
+
+#include "bench.hpp"
+#include "ctd/column_codec.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+#ifdef CTD_BENCH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+    using sample = ctd::current<int32_t, ctd::micro>;
+    using codec = ctd::column_codec<sample>;
+
+    constexpr size_t samples = 1 << 20;
+
+    std::vector<sample> make_signal() {
+        std::srand(1);
+        std::vector<sample> v(samples);
+        int32_t x = 500000;
+        for (auto& s : v) {
+            x += std::rand() % 15 - 7;
+            s = x;
+        }
+        return v;
+    }
+
+    // Returns millions of samples per second for a scan that decodes and sums the whole log.
+    template <typename F>
+    double scan_rate(F&& f) {
+        return samples / bench::ns_per_call(f, 1) * 1e3;
+    }
+}
+
+int main() {
+    const auto signal = make_signal();
+    const double raw_bytes = double(samples * sizeof(int32_t));
+
+    std::vector<uint8_t> encoded(codec::max_bytes(samples));
+    size_t bytes = 0;
+    const double encode_ns = bench::ns_per_call([&] {
+        bytes = codec::encode(signal.data(), samples, encoded.data());
+        bench::clobber_memory();
+    }, 1);
+    bench::report("column_codec compression ratio", raw_bytes / bytes, "x");
+    bench::report("column_codec encode", samples / encode_ns * 1e3, "M samples/s");
+
+    std::vector<sample> decoded(samples);
+    bench::report("column_codec decode and sum", scan_rate([&] {
+        const size_t n = codec::decode(encoded.data(), bytes, decoded.data(), decoded.size());
+        int64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += decoded[i].count();
+        }
+        bench::do_not_optimize(sum);
+    }), "M samples/s");
+
+    bench::report("raw counts sum", scan_rate([&] {
+        int64_t sum = 0;
+        for (const auto& s : signal) {
+            sum += s.count();
+        }
+        bench::do_not_optimize(sum);
+    }), "M samples/s");
+
+#ifdef CTD_BENCH_ZLIB
+    uLongf deflated = compressBound(uLong(raw_bytes));
+    std::vector<Bytef> archive(deflated);
+    compress2(archive.data(), &deflated, reinterpret_cast<const Bytef*>(signal.data()), uLong(raw_bytes), 6);
+    bench::report("zlib level 6 compression ratio", raw_bytes / deflated, "x");
+
+    std::vector<int32_t> inflated(samples);
+    bench::report("zlib inflate and sum", scan_rate([&] {
+        uLongf size = uLongf(raw_bytes);
+        uncompress(reinterpret_cast<Bytef*>(inflated.data()), &size, archive.data(), deflated);
+        int64_t sum = 0;
+        for (int32_t s : inflated) {
+            sum += s;
+        }
+        bench::do_not_optimize(sum);
+    }), "M samples/s");
+#endif
+    return 0;
+}
@@ -0,0 +1,125 @@
+// In-place FFT of Q15, Q31 and float complex quantities for sizes from 64 to 4096, in microseconds per transform and
+// nanoseconds per N log2 N, compared to a textbook radix-2 Q15 FFT on raw int16_t pairs.
+
+#include "bench.hpp"
+#include "ctd/fft.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+    template <typename C>
+    C make_sample(double v) {
+        using T = typename C::value_type;
+        if constexpr (std::numeric_limits<T>::is_integer) {
+            return C(static_cast<T>(v * std::numeric_limits<T>::max()));
+        }
+        else {
+            return C(static_cast<T>(v));
+        }
+    }
+
+    template <typename C, size_t N>
+    void run(const char* type) {
+        using sample = ctd::voltage<C, ctd::milli>;
+        std::srand(1);
+        std::vector<sample> signal(N);
+        for (size_t i = 0; i < N; ++i) {
+            signal[i] = make_sample<C>(0.5 * std::sin(0.1 * double(i)) + 0.001 * (std::rand() % 201 - 100));
+        }
+        std::vector<sample> data(N);
+        // The copy keeps the input the same for every call, it is a small part of the time.
+        const double ns = bench::ns_per_call([&] {
+            data = signal;
+            ctd::fft<N>(data.data());
+            bench::clobber_memory();
+        }, 4096 * 64 / N);
+        char name[64];
+        std::snprintf(name, sizeof(name), "fft %s N=%zu", type, N);
+        bench::report(name, ns / 1000, "us");
+        std::snprintf(name, sizeof(name), "fft %s N=%zu per N log2 N", type, N);
+        bench::report(name, ns / (double(N) * ctd::detail::fft_log2(N)), "ns");
+    }
+
+    struct raw_q15 {
+        int16_t re;
+        int16_t im;
+    };
+
+    // Radix-2 decimation in time with a full twiddle table, halving every stage.
+    template <size_t N>
+    void textbook_fft(raw_q15* x, const int16_t* cos_table, const int16_t* sin_table) {
+        for (size_t i = 1, j = 0; i < N; ++i) {
+            size_t bit = N >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                const raw_q15 t = x[i];
+                x[i] = x[j];
+                x[j] = t;
+            }
+        }
+        for (size_t h = 1; h < N; h *= 2) {
+            const size_t stride = N / (2 * h);
+            for (size_t k = 0; k < h; ++k) {
+                const int32_t wr = cos_table[k * stride];
+                const int32_t wi = -sin_table[k * stride];
+                for (size_t j = k; j < N; j += 2 * h) {
+                    const raw_q15 a = x[j];
+                    const raw_q15 b = x[j + h];
+                    const int32_t tr = (wr * b.re - wi * b.im + 16384) >> 15;
+                    const int32_t ti = (wr * b.im + wi * b.re + 16384) >> 15;
+                    x[j] = { int16_t((a.re + tr + 1) >> 1), int16_t((a.im + ti + 1) >> 1) };
+                    x[j + h] = { int16_t((a.re - tr + 1) >> 1), int16_t((a.im - ti + 1) >> 1) };
+                }
+            }
+        }
+    }
+
+    template <size_t N>
+    void run_textbook() {
+        std::vector<int16_t> cos_table(N);
+        std::vector<int16_t> sin_table(N);
+        std::vector<raw_q15> signal(N);
+        std::srand(1);
+        for (size_t i = 0; i < N; ++i) {
+            cos_table[i] = static_cast<int16_t>(std::lround(32767 * std::cos(2 * 3.14159265358979 * i / N)));
+            sin_table[i] = static_cast<int16_t>(std::lround(32767 * std::sin(2 * 3.14159265358979 * i / N)));
+            signal[i] = { static_cast<int16_t>(16000 * std::sin(0.1 * double(i)) + std::rand() % 201 - 100), 0 };
+        }
+        std::vector<raw_q15> data(N);
+        const double ns = bench::ns_per_call([&] {
+            data = signal;
+            textbook_fft<N>(data.data(), cos_table.data(), sin_table.data());
+            bench::clobber_memory();
+        }, 4096 * 64 / N);
+        char name[64];
+        std::snprintf(name, sizeof(name), "textbook radix-2 Q15 N=%zu", N);
+        bench::report(name, ns / 1000, "us");
+    }
+
+    template <typename C>
+    void run_all(const char* type) {
+        run<C, 64>(type);
+        run<C, 256>(type);
+        run<C, 1024>(type);
+        run<C, 4096>(type);
+    }
+}
+
+int main() {
+    run_all<ctd::fixed_complex<int16_t>>("Q15");
+    run_all<ctd::fixed_complex<int32_t>>("Q31");
+    run_all<std::complex<float>>("float");
+    run_textbook<64>();
+    run_textbook<256>();
+    run_textbook<1024>();
+    run_textbook<4096>();
+    return 0;
+}
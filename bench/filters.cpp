@@ -0,0 +1,76 @@
+// Throughput of the streaming filters on random 16 bit samples. The sliding median is also compared to the naive
+// approach of copying the window and running std::nth_element for every sample.
+
+#include "bench.hpp"
+#include "ctd/filters.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+    using sample = ctd::voltage<int16_t, ctd::milli>;
+
+    constexpr size_t samples = 1 << 16;
+    constexpr size_t iterations = 4000000;
+
+    std::vector<sample> random_samples() {
+        std::mt19937 rng(42);
+        std::vector<sample> s(samples);
+        for (auto& x : s) {
+            x = sample(static_cast<int16_t>(rng() % 4096 - 2048));
+        }
+        return s;
+    }
+
+    template <typename Filter>
+    void run(const char* name, const std::vector<sample>& input) {
+        Filter f;
+        size_t i = 0;
+        bench::report(name, bench::ns_per_call([&] {
+            bench::do_not_optimize(f.push(input[i]));
+            i = (i + 1) % samples;
+        }, iterations), "ns/sample");
+    }
+
+    template <size_t N>
+    class naive_median {
+    public:
+        sample push(sample q) {
+            window[next] = q;
+            next = (next + 1) % N;
+            n += n < N;
+            sample copy[N];
+            std::copy_n(window, n, copy);
+            std::nth_element(copy, copy + n / 2, copy + n);
+            return copy[n / 2];
+        }
+
+    private:
+        sample window[N]{};
+        size_t next = 0;
+        size_t n = 0;
+    };
+
+    struct variance_adapter {
+        ctd::running_variance<sample> v;
+        auto push(sample q) {
+            v.push(q);
+            return v.mean();
+        }
+    };
+}  // namespace
+
+int main() {
+    const std::vector<sample> input = random_samples();
+
+    run<ctd::moving_average<sample, 16>>("moving_average<16>", input);
+    run<ctd::moving_average<sample, 100>>("moving_average<100>", input);
+    run<ctd::exponential_smoothing<sample, ctd::ratio<1, 8>>>("exponential_smoothing<1/8>", input);
+    run<ctd::exponential_smoothing<sample, ctd::ratio<1, 10>>>("exponential_smoothing<1/10>", input);
+    run<variance_adapter>("running_variance", input);
+    run<ctd::running_median<sample, 9>>("running_median<9>", input);
+    run<naive_median<9>>("median of 9 (std::nth_element)", input);
+    run<ctd::running_median<sample, 63>>("running_median<63>", input);
+    run<naive_median<63>>("median of 63 (std::nth_element)", input);
+}
@@ -0,0 +1,63 @@
+// Rotations per second of int16_t and float IMU samples, one vector at a time with rotate() and in batches with
+// the SIMD kernels, compared to the scalar batch loop.
+
+#include "bench.hpp"
+#include "ctd/linalg.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+    using accel = ctd::quantity<int16_t, ctd::units::acceleration, ctd::ratio<1, 1000>>;
+    using q15 = ctd::quantity<int16_t, ctd::units::unity, ctd::ratio<1, 32768>>;
+    using accel_f = ctd::quantity<float, ctd::units::acceleration, ctd::ratio<1>>;
+    using unity_f = ctd::quantity<float, ctd::units::unity, ctd::ratio<1>>;
+
+    constexpr size_t batch = 1024;
+    constexpr size_t batches = 20000;
+
+    template <typename F>
+    void run(const char* name, F&& f) {
+        const double ns = bench::ns_per_call(f, batches);
+        bench::report(name, batch / ns * 1e3, "Mrot/s");
+    }
+}  // namespace
+
+int main() {
+    const double a = 0.3;
+    const auto q = [](double v) { return q15(static_cast<int16_t>(std::lround(v * 32767))); };
+    const ctd::mat3<q15> r({ q(std::cos(a)), q(-std::sin(a)), q(0) }, { q(std::sin(a)), q(std::cos(a)), q(0) },
+        { q(0), q(0), q(1) });
+    const auto f = [](double v) { return unity_f(static_cast<float>(v)); };
+    const ctd::mat3<unity_f> rf({ f(std::cos(a)), f(-std::sin(a)), f(0) }, { f(std::sin(a)), f(std::cos(a)), f(0) },
+        { f(0), f(0), f(1) });
+
+    std::mt19937 rng(9);
+    std::vector<ctd::vec3<accel>> in(batch), out(batch);
+    std::vector<ctd::vec3<accel_f>> in_f(batch), out_f(batch);
+    for (size_t i = 0; i < batch; ++i) {
+        const auto c = [&] { return accel(static_cast<int16_t>(rng() % 40000 - 20000)); };
+        in[i] = ctd::vec3<accel>(c(), c(), c());
+        in_f[i] = ctd::vec3<accel_f>(accel_f(in[i].x().count() * 1e-3f), accel_f(in[i].y().count() * 1e-3f),
+            accel_f(in[i].z().count() * 1e-3f));
+    }
+
+    run("int16_t scalar", [&] {
+        ctd::detail::rotate_scalar(r, in.data(), out.data(), batch);
+        bench::clobber_memory();
+    });
+    run("int16_t batch", [&] {
+        ctd::rotate(r, in.data(), out.data(), batch);
+        bench::clobber_memory();
+    });
+    run("float scalar", [&] {
+        ctd::detail::rotate_scalar(rf, in_f.data(), out_f.data(), batch);
+        bench::clobber_memory();
+    });
+    run("float batch", [&] {
+        ctd::rotate(rf, in_f.data(), out_f.data(), batch);
+        bench::clobber_memory();
+    });
+}
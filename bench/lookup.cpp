@@ -0,0 +1,69 @@
+// Thermistor table lookup with uniform_interpolation_table and interpolation_table, compared to the usual linear
+// scan and interpolation over double arrays.
+
+#include "bench.hpp"
+#include "ctd/lookup.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr int32_t ntc[] = { 332094, 239900, 175200, 129287, 96358, 72500, 55046, 42157, 32554, 25339, 19872,
+        15698, 12488, 10000, 8059, 6535, 5330, 4372, 3605, 2989, 2490, 2084, 1753, 1481, 1256 };
+    constexpr size_t n = sizeof(ntc) / sizeof(ntc[0]);
+
+    using input = ctd::temperature<int16_t, ctd::deci>;
+    using output = ctd::resistance<int32_t>;
+
+    constexpr ctd::uniform_interpolation_table<input, output, n, ctd::ratio<-40>, ctd::ratio<5>> uniform(ntc);
+
+    constexpr int16_t grid[] = { -400, -350, -300, -250, -200, -150, -100, -50, 0, 50, 100, 150, 200, 250, 300, 350,
+        400, 450, 500, 550, 600, 650, 700, 750, 800 };
+    constexpr ctd::interpolation_table<input, output, n> search(grid, ntc);
+
+    double grid_double[n];
+    double ntc_double[n];
+
+    constexpr size_t samples = 1 << 12;
+
+    template <typename F>
+    void run(const char* name, const std::vector<input>& in, F&& f) {
+        size_t i = 0;
+        bench::report(name, bench::ns_per_call([&] {
+            bench::do_not_optimize(f(in[i]));
+            i = (i + 1) % samples;
+        }, 20000000), "ns");
+    }
+}  // namespace
+
+int main() {
+    for (size_t i = 0; i < n; ++i) {
+        grid_double[i] = grid[i] * 0.1;
+        ntc_double[i] = ntc[i];
+    }
+    std::mt19937 rng(7);
+    std::vector<input> in(samples);
+    for (auto& x : in) {
+        x = input(static_cast<int16_t>(rng() % 1300 - 450));
+    }
+
+    run("uniform_interpolation_table", in, [](input x) { return uniform(x); });
+    run("interpolation_table", in, [](input x) { return search(x); });
+    run("double linear scan", in, [](input x) {
+        const double t = x.count() * 0.1;
+        double r = ntc_double[n - 1];
+        if (t <= grid_double[0]) {
+            r = ntc_double[0];
+        }
+        else {
+            for (size_t i = 0; i + 1 < n; ++i) {
+                if (t < grid_double[i + 1]) {
+                    r = ntc_double[i] + (ntc_double[i + 1] - ntc_double[i]) * (t - grid_double[i]) /
+                        (grid_double[i + 1] - grid_double[i]);
+                    break;
+                }
+            }
+        }
+        return output(static_cast<int32_t>(r + 0.5));
+    });
+}
@@ -0,0 +1,50 @@
+// Unpacking 12 bit ADC samples from a packed_quantity_array into 16 bit quantities, compared to reading them one at a
+// time and to copying an unpacked array of the same samples.
+
+#include "bench.hpp"
+#include "ctd/packed_quantity_array.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+namespace {
+    constexpr size_t samples = 4096;
+    using packed = ctd::packed_quantity_array<12, ctd::units::volt, ctd::milli, samples>;
+    using sample = packed::quantity_type;
+}
+
+int main() {
+    static packed a;
+    std::vector<sample> raw(samples);
+    std::srand(1);
+    for (size_t i = 0; i < samples; ++i) {
+        raw[i] = sample(static_cast<uint16_t>(std::rand() & 0xFFF));
+        a.set(i, raw[i]);
+    }
+    bench::report("packed bytes per sample", double(sizeof(a)) / samples, "B");
+    bench::report("unpacked bytes per sample", double(sizeof(sample)), "B");
+
+    std::vector<sample> out(samples);
+    const double bulk = bench::ns_per_call([&] {
+        a.unpack(out.data());
+        bench::clobber_memory();
+    }, 2000);
+    bench::report("packed_quantity_array unpack", bulk / samples, "ns/sample");
+
+    const double single = bench::ns_per_call([&] {
+        for (size_t i = 0; i < samples; ++i) {
+            out[i] = a.get(i);
+        }
+        bench::clobber_memory();
+    }, 2000);
+    bench::report("packed_quantity_array get", single / samples, "ns/sample");
+
+    const double copy = bench::ns_per_call([&] {
+        for (size_t i = 0; i < samples; ++i) {
+            out[i] = raw[i];
+        }
+        bench::clobber_memory();
+    }, 2000);
+    bench::report("unpacked copy", copy / samples, "ns/sample");
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Scaling of parallel::reduce, transform and minmax over 64M millivolt readings from one thread up to one per
+// hardware thread, compared to a scalar loop through quantity::operator+. The reductions are memory bound once a
+// few threads run, so the speedup levels off at the memory bandwidth. The largest thread count can be given as the
+// first argument.
+
+#include "bench.hpp"
+#include "ctd/parallel.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using millivolts = ctd::voltage<int16_t, ctd::milli>;
+    using microvolts = ctd::voltage<int32_t, ctd::micro>;
+
+    constexpr size_t samples = size_t(1) << 26;
+
+    template <typename F>
+    double ms(F&& f, int repeats = 5) {
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            f();
+            auto end = std::chrono::steady_clock::now();
+            const double t = std::chrono::duration<double, std::milli>(end - start).count();
+            best = t < best ? t : best;
+        }
+        return best;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<millivolts> in(samples);
+    std::mt19937 rng(7);
+    for (auto& x : in) {
+        x = millivolts(static_cast<int16_t>(rng()));
+    }
+    std::vector<microvolts> out(samples);
+    const millivolts* first = in.data();
+    const millivolts* last = in.data() + in.size();
+
+    bench::report("serial operator+", ms([&] {
+        ctd::voltage<int64_t, ctd::milli> sum = 0;
+        for (const auto& x : in) {
+            sum = sum + x;
+        }
+        bench::do_not_optimize(sum);
+    }), "ms");
+
+    const unsigned hardware = argc > 1 ? unsigned(std::atoi(argv[1])) : std::thread::hardware_concurrency();
+    for (unsigned threads = 1;; threads = threads * 2 < hardware ? threads * 2 : hardware) {
+        ctd::parallel::thread_pool pool(threads);
+        const std::string suffix = " threads=" + std::to_string(threads);
+        bench::report(("reduce" + suffix).c_str(), ms([&] {
+            bench::do_not_optimize(ctd::parallel::reduce(first, last, pool));
+        }), "ms");
+        bench::report(("transform mV->uV" + suffix).c_str(), ms([&] {
+            ctd::parallel::transform(first, last, out.data(), pool);
+            bench::clobber_memory();
+        }), "ms");
+        bench::report(("minmax" + suffix).c_str(), ms([&] {
+            bench::do_not_optimize(ctd::parallel::minmax(first, last, pool));
+        }), "ms");
+        if (threads >= hardware) {
+            break;
+        }
+    }
+}
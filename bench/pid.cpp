@@ -0,0 +1,83 @@
+// Time per update of pid_controller compared to a typical hand written fixed-point PID, which keeps its gains as
+// run time fractions and divides in every update, and to a float PID.
+
+#include "bench.hpp"
+#include "ctd/pid.hpp"
+
+#include <random>
+#include <vector>
+
+namespace {
+    using error_type = ctd::current<int16_t, ctd::milli>;
+    using output_type = ctd::voltage<int16_t, ctd::milli>;
+
+    constexpr size_t samples = 1 << 12;
+    constexpr size_t iterations = 20000000;
+
+    // Kp = 0.35 V/A, Ki = 120 V/As and Kd = 0.0004 Vs/A at 10 kHz, from mA to mV.
+    using kp = ctd::ratio<35, 100>;
+    using ki = ctd::ratio<120>;
+    using kd = ctd::ratio<4, 10000>;
+    using period = ctd::ratio<1, 10000>;
+
+    class hand_written_pid {
+    public:
+        output_type update(error_type error) {
+            const int32_t e = error.count();
+            const int32_t p = e * kp_num / kp_den;
+            integral += int64_t(e) * ki_num;
+            const int64_t lo = int64_t(min) * ki_den;
+            const int64_t hi = int64_t(max) * ki_den;
+            integral = integral < lo ? lo : integral > hi ? hi : integral;
+            const int32_t i = static_cast<int32_t>(integral / ki_den);
+            const int32_t d = (e - prev) * kd_num / kd_den;
+            prev = e;
+            const int32_t u = p + i + d;
+            return static_cast<int16_t>(u < min ? min : u > max ? max : u);
+        }
+
+        // Gains in mV per mA, read from a configuration at run time.
+        int32_t kp_num = 35;
+        int32_t kp_den = 100;
+        int32_t ki_num = 120;
+        int32_t ki_den = 10000;
+        int32_t kd_num = 4;
+        int32_t kd_den = 1;
+        int16_t min = -12000;
+        int16_t max = 12000;
+
+    private:
+        int64_t integral = 0;
+        int32_t prev = 0;
+    };
+
+    template <typename Controller, typename Input>
+    void run(const char* name, Controller& c, const std::vector<Input>& input) {
+        size_t i = 0;
+        bench::report(name, bench::ns_per_call([&] {
+            bench::do_not_optimize(c.update(input[i]));
+            i = (i + 1) % samples;
+        }, iterations), "ns/update");
+    }
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<error_type> errors(samples);
+    std::vector<ctd::current<float>> float_errors(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        errors[i] = static_cast<int16_t>(rng() % 2001 - 1000);
+        float_errors[i] = errors[i].count() * 1e-3f;
+    }
+
+    ctd::pid_controller<error_type, output_type, period, kp, ki, kd> pid(output_type(-12000), output_type(12000));
+    run("pid_controller int16_t", pid, errors);
+
+    hand_written_pid hand;
+    run("hand written pid, run time gains", hand, errors);
+
+    using float_pid = ctd::pid_controller<ctd::current<float>, ctd::voltage<float>, period, kp, ki, kd>;
+    float_pid fpid(ctd::voltage<float>(-12.0f), ctd::voltage<float>(12.0f));
+    run("pid_controller float", fpid, float_errors);
+    return 0;
+}
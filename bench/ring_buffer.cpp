@@ -0,0 +1,148 @@
+// Producer to consumer throughput and round trip latency of spsc_ring_buffer compared to a mutex protected queue.
+// The spin loops yield so that the benchmark also completes on single core machines.
+
+#include "bench.hpp"
+#include "ctd/ring_buffer.hpp"
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+    using sample = ctd::voltage<int16_t, ctd::milli>;
+
+    constexpr size_t capacity = 1024;
+    constexpr size_t items = 20000000;
+
+    class mutex_queue {
+    public:
+        bool push(const sample& s) {
+            std::lock_guard<std::mutex> lock(m);
+            if (q.size() == capacity) {
+                return false;
+            }
+            q.push_back(s);
+            return true;
+        }
+
+        size_t push(const sample* s, size_t n) {
+            std::lock_guard<std::mutex> lock(m);
+            size_t i = 0;
+            for (; i < n && q.size() < capacity; ++i) {
+                q.push_back(s[i]);
+            }
+            return i;
+        }
+
+        bool pop(sample& s) {
+            std::lock_guard<std::mutex> lock(m);
+            if (q.empty()) {
+                return false;
+            }
+            s = q.front();
+            q.pop_front();
+            return true;
+        }
+
+        size_t pop(sample* s, size_t n) {
+            std::lock_guard<std::mutex> lock(m);
+            size_t i = 0;
+            for (; i < n && !q.empty(); ++i) {
+                s[i] = q.front();
+                q.pop_front();
+            }
+            return i;
+        }
+
+    private:
+        std::mutex m;
+        std::deque<sample> q;
+    };
+
+    // Returns millions of items per second moved from a producer to a consumer thread.
+    template <typename Queue>
+    double throughput(size_t batch) {
+        Queue q;
+        auto start = std::chrono::steady_clock::now();
+        std::thread producer([&] {
+            sample buf[64];
+            for (size_t i = 0; i < 64; ++i) {
+                buf[i] = static_cast<int16_t>(i);
+            }
+            size_t sent = 0;
+            while (sent < items) {
+                size_t n = batch == 1 ? (q.push(buf[sent & 63]) ? 1 : 0)
+                    : q.push(buf, batch < items - sent ? batch : items - sent);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                sent += n;
+            }
+        });
+
+        size_t received = 0;
+        int sum = 0;
+        sample buf[64];
+        while (received < items) {
+            size_t n = batch == 1 ? (q.pop(buf[0]) ? 1 : 0) : q.pop(buf, batch);
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+            for (size_t i = 0; i < n; ++i) {
+                sum += buf[i].count();
+            }
+            received += n;
+        }
+        producer.join();
+        bench::do_not_optimize(sum);
+
+        auto end = std::chrono::steady_clock::now();
+        return items / std::chrono::duration<double, std::micro>(end - start).count();
+    }
+
+    // Returns the mean round trip time in nanoseconds of one sample sent to another thread and back.
+    template <typename Queue>
+    double round_trip() {
+        constexpr size_t trips = 100000;
+        Queue ping;
+        Queue pong;
+        std::thread echo([&] {
+            sample s;
+            for (size_t i = 0; i < trips; ++i) {
+                while (!ping.pop(s)) {
+                    std::this_thread::yield();
+                }
+                while (!pong.push(s)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        auto start = std::chrono::steady_clock::now();
+        sample s = 1;
+        for (size_t i = 0; i < trips; ++i) {
+            while (!ping.push(s)) {
+                std::this_thread::yield();
+            }
+            while (!pong.pop(s)) {
+                std::this_thread::yield();
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        echo.join();
+        return std::chrono::duration<double, std::nano>(end - start).count() / trips;
+    }
+}
+
+int main() {
+    using ring = ctd::spsc_ring_buffer<sample, capacity>;
+
+    bench::report("spsc_ring_buffer throughput, single", throughput<ring>(1), "M items/s");
+    bench::report("mutex queue throughput, single", throughput<mutex_queue>(1), "M items/s");
+    bench::report("spsc_ring_buffer throughput, batch of 64", throughput<ring>(64), "M items/s");
+    bench::report("mutex queue throughput, batch of 64", throughput<mutex_queue>(64), "M items/s");
+    bench::report("spsc_ring_buffer round trip", round_trip<ring>(), "ns");
+    bench::report("mutex queue round trip", round_trip<mutex_queue>(), "ns");
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+* This file provides an implementation of <algorithm> which is from std:: if HAS_STL is true, and from CTD otherwise.
+* This file also provides sorting networks for small, fixed size arrays.
+*/
+#ifndef CTD_ALGORITHM_HPP
+#define CTD_ALGORITHM_HPP
+
+#include "stl_switch.hpp"
+
+#ifdef HAS_STL
+#include <algorithm>
+#include <cstddef>
+#else
+#include "algorithm_impl.hpp"
+#endif
+
+namespace ctd {
+    namespace detail {
+        struct comparator_pair {
+            size_t i;
+            size_t j;
+        };
+
+        // Knuth's merge exchange (algorithm 5.2.2M), Batcher's odd-even merge generalized to any N. Returns the number
+        // of comparators and stores them in 'out' unless it is null.
+        constexpr size_t merge_exchange(size_t n, comparator_pair* out) {
+            if (n < 2) {
+                return 0;
+            }
+            size_t t = 0;
+            while ((size_t(1) << t) < n) {
+                ++t;
+            }
+            size_t count = 0;
+            for (size_t p = size_t(1) << (t - 1); p > 0; p >>= 1) {
+                size_t q = size_t(1) << (t - 1);
+                size_t r = 0;
+                size_t d = p;
+                while (d > 0) {
+                    for (size_t i = 0; i + d < n; ++i) {
+                        if ((i & p) == r) {
+                            if (out) {
+                                out[count] = { i, i + d };
+                            }
+                            ++count;
+                        }
+                    }
+                    d = q - p;
+                    q >>= 1;
+                    r = p;
+                }
+            }
+            return count;
+        }
+
+        template <size_t N>
+        struct sorting_network {
+            constexpr static size_t count() { return merge_exchange(N, nullptr); }
+
+            comparator_pair pairs[count() > 0 ? count() : 1];
+
+            constexpr sorting_network() : pairs() { merge_exchange(N, pairs); }
+        };
+
+        template <size_t N>
+        constexpr sorting_network<N> sorting_network_v{};
+
+        // Quantities with a positive scale are ordered like their counts.
+        template <typename T>
+        concept count_ordered = requires(const T& t) {
+            T(t.count());
+            requires T::scale::num > 0;
+        };
+
+        template <typename T>
+        constexpr void compare_exchange(T& a, T& b) {
+            // Written as a select rather than a conditional swap so that the compiler emits branch free code.
+            const bool swap = b < a;
+            const T lo = swap ? b : a;
+            const T hi = swap ? a : b;
+            a = lo;
+            b = hi;
+        }
+
+        // Applies the comparators one by one through recursion, which unrolls the network into straight line code.
+        template <size_t N, size_t I, typename T>
+        constexpr void apply_network(T* data) {
+            if constexpr (I < sorting_network<N>::count()) {
+                constexpr comparator_pair c = sorting_network_v<N>.pairs[I];
+                compare_exchange(data[c.i], data[c.j]);
+                apply_network<N, I + 1>(data);
+            }
+        }
+    }  // namespace detail
+
+    // Sorts N elements in ascending order with a sorting network. Intended for small N where the network compiles
+    // to a short sequence of branch free min/max operations.
+    template <size_t N, typename T>
+    constexpr void static_sort(T* data) {
+        if constexpr (detail::count_ordered<T>) {
+            // Compilers only emit branch free selects for scalars, so quantities are sorted by their counts.
+            decltype(data->count()) counts[N > 0 ? N : 1] = {};
+            for (size_t i = 0; i < N; ++i) {
+                counts[i] = data[i].count();
+            }
+            detail::apply_network<N, 0>(&counts[0]);
+            for (size_t i = 0; i < N; ++i) {
+                data[i] = T(counts[i]);
+            }
+        }
+        else {
+            detail::apply_network<N, 0>(data);
+        }
+    }
+
+    template <size_t N, typename T>
+    constexpr void static_sort(T(&data)[N]) {
+        static_sort<N>(&data[0]);
+    }
+
+    // Returns the median of N elements, for even N the upper of the two middle elements. The data is copied and
+    // sorted with a sorting network, after inlining the compiler removes the comparators that don't contribute to
+    // the middle element.
+    template <size_t N, typename T>
+    constexpr T median(const T* data) {
+        static_assert(N > 0, "The median of nothing is undefined");
+        T copy[N] = {};
+        for (size_t i = 0; i < N; ++i) {
+            copy[i] = data[i];
+        }
+        static_sort<N>(&copy[0]);
+        return copy[N / 2];
+    }
+
+    template <size_t N, typename T>
+    constexpr T median(const T(&data)[N]) {
+        return median<N>(&data[0]);
+    }
+}  // namespace ctd
+
+#endif // CTD_ALGORITHM_HPP
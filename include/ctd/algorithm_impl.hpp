@@ -0,0 +1,191 @@
+/**
+* This file provides a compatible implementation of a subset of <algorithm> for systems where STL isn't present.
+*/
+#ifndef CTD_ALGORITHM_IMPL_HPP
+#define CTD_ALGORITHM_IMPL_HPP
+
+#include "common.hpp"
+
+namespace ctd_impl {
+    struct less {
+        template <typename T, typename U>
+        constexpr bool operator()(const T& a, const U& b) const {
+            return a < b;
+        }
+    };
+
+    template <typename T>
+    constexpr void swap(T& a, T& b) {
+        T tmp = static_cast<T&&>(a);
+        a = static_cast<T&&>(b);
+        b = static_cast<T&&>(tmp);
+    }
+
+    template <typename T, typename Compare = less>
+    constexpr const T& min(const T& a, const T& b, Compare comp = Compare()) {
+        return comp(b, a) ? b : a;
+    }
+
+    template <typename T, typename Compare = less>
+    constexpr const T& max(const T& a, const T& b, Compare comp = Compare()) {
+        return comp(a, b) ? b : a;
+    }
+
+    template <typename T, typename Compare = less>
+    constexpr const T& clamp(const T& v, const T& lo, const T& hi, Compare comp = Compare()) {
+        return comp(v, lo) ? lo : comp(hi, v) ? hi : v;
+    }
+
+    template <typename T1, typename T2>
+    struct pair {
+        T1 first;
+        T2 second;
+    };
+
+    template <typename T, typename Compare = less>
+    constexpr pair<const T&, const T&> minmax(const T& a, const T& b, Compare comp = Compare()) {
+        if (comp(b, a)) {
+            return { b, a };
+        }
+        return { a, b };
+    }
+
+    namespace detail {
+        template <typename It, typename Compare>
+        constexpr void insertion_sort(It first, It last, Compare& comp) {
+            if (first == last) {
+                return;
+            }
+            for (It i = first + 1; i != last; ++i) {
+                auto v = *i;
+                It j = i;
+                for (; j != first && comp(v, *(j - 1)); --j) {
+                    *j = *(j - 1);
+                }
+                *j = v;
+            }
+        }
+
+        template <typename It, typename Compare>
+        constexpr void sift_down(It first, ptrdiff_t i, ptrdiff_t n, Compare& comp) {
+            for (;;) {
+                ptrdiff_t child = 2 * i + 1;
+                if (child >= n) {
+                    return;
+                }
+                if (child + 1 < n && comp(first[child], first[child + 1])) {
+                    ++child;
+                }
+                if (!comp(first[i], first[child])) {
+                    return;
+                }
+                ctd_impl::swap(first[i], first[child]);
+                i = child;
+            }
+        }
+
+        template <typename It, typename Compare>
+        constexpr void heap_sort(It first, It last, Compare& comp) {
+            const ptrdiff_t n = last - first;
+            for (ptrdiff_t i = n / 2; i-- > 0;) {
+                sift_down(first, i, n, comp);
+            }
+            for (ptrdiff_t end = n - 1; end > 0; --end) {
+                ctd_impl::swap(first[0], first[end]);
+                sift_down(first, 0, end, comp);
+            }
+        }
+
+        // Hoare partition around the median of the first, middle and last element. Returns the start of the upper
+        // part, both parts are non-empty.
+        template <typename It, typename Compare>
+        constexpr It partition(It first, It last, Compare& comp) {
+            It mid = first + (last - first) / 2;
+            It back = last - 1;
+            if (comp(*mid, *first)) {
+                ctd_impl::swap(*mid, *first);
+            }
+            if (comp(*back, *mid)) {
+                ctd_impl::swap(*back, *mid);
+                if (comp(*mid, *first)) {
+                    ctd_impl::swap(*mid, *first);
+                }
+            }
+            auto pivot = *mid;
+
+            It i = first;
+            It j = last;
+            for (;;) {
+                while (comp(*i, pivot)) {
+                    ++i;
+                }
+                --j;
+                while (comp(pivot, *j)) {
+                    --j;
+                }
+                if (!(i < j)) {
+                    return j + 1;
+                }
+                ctd_impl::swap(*i, *j);
+                ++i;
+            }
+        }
+
+        // Small ranges are left to insertion sort, which is faster there than partitioning further.
+        inline constexpr ptrdiff_t insertion_sort_threshold = 16;
+    }  // namespace detail
+
+    // Introsort: quicksort that falls back to heap sort when the recursion gets too deep, so the worst case stays
+    // O(n log n). Recursion only happens on the smaller part, the stack depth is bounded by log2(n).
+    template <typename It, typename Compare = less>
+    constexpr void sort(It first, It last, Compare comp = Compare()) {
+        int depth = 0;
+        for (ptrdiff_t n = last - first; n > 1; n >>= 1) {
+            depth += 2;
+        }
+        while (last - first > detail::insertion_sort_threshold) {
+            if (depth-- == 0) {
+                detail::heap_sort(first, last, comp);
+                return;
+            }
+            It cut = detail::partition(first, last, comp);
+            if (cut - first < last - cut) {
+                ctd_impl::sort(first, cut, comp);
+                first = cut;
+            }
+            else {
+                ctd_impl::sort(cut, last, comp);
+                last = cut;
+            }
+        }
+        detail::insertion_sort(first, last, comp);
+    }
+
+    // Quickselect, with the same heap sort fallback as sort() for adversarial inputs.
+    template <typename It, typename Compare = less>
+    constexpr void nth_element(It first, It nth, It last, Compare comp = Compare()) {
+        if (nth == last) {
+            return;
+        }
+        int depth = 0;
+        for (ptrdiff_t n = last - first; n > 1; n >>= 1) {
+            depth += 2;
+        }
+        while (last - first > detail::insertion_sort_threshold) {
+            if (depth-- == 0) {
+                detail::heap_sort(first, last, comp);
+                return;
+            }
+            It cut = detail::partition(first, last, comp);
+            if (nth < cut) {
+                last = cut;
+            }
+            else {
+                first = cut;
+            }
+        }
+        detail::insertion_sort(first, last, comp);
+    }
+}  // namespace ctd_impl
+
+#endif
@@ -0,0 +1,199 @@
+/*
+* This file provides binary angle measurement (BAM), an angle representation where the full range of an unsigned
+* integer spans exactly one turn. Overflow is then the natural 2*pi wrap-around, and sine/cosine are computed from a
+* compile time generated lookup table instead of floating point.
+*/
+#ifndef CTD_ANGLE_HPP
+#define CTD_ANGLE_HPP
+
+#include <cstdint>
+
+#ifdef HAS_STL
+#include <cmath>
+#endif
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // A rational approximation of pi, the absolute error is less than 6e-10.
+    using ratio_pi = ratio<103993, 33102>;
+
+    // Scale of an angle in degrees when the units are radians. Note that pi cancels out exactly when converting
+    // between degrees and binary angles.
+    using degree = ratio_divide<ratio_pi, ratio<180>>;
+
+    template <typename type, typename scale = ratio<1>>
+    using angle = quantity<type, units::radian, scale>;
+
+    namespace detail {
+        template <typename T>
+        using bam_signed_t = conditional_t<sizeof(T) == 1, int8_t,
+            conditional_t<sizeof(T) == 2, int16_t, int32_t>>;
+
+        // Result type of the table driven trigonometric functions, sized to the precision of the angle.
+        template <typename T>
+        using bam_trig_t = conditional_t<sizeof(T) <= 2, int16_t, int32_t>;
+
+        // Taylor series of sin(x) for |x| <= pi/2. Only used to generate lookup tables at compile time.
+        constexpr double sin_taylor(double x) {
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 14; ++n) {
+                term *= -x * x / ((2 * n) * (2 * n + 1));
+                sum += term;
+            }
+            return sum;
+        }
+
+        // A quarter wave of sin(x) sampled at 2^TableBits + 1 points in [0, pi/2], scaled so that 1.0 maps to the
+        // largest value of V. One extra sample past pi/2 lets the interpolation read the next sample without a
+        // bounds check.
+        template <typename V, int TableBits>
+        struct sine_table {
+            constexpr static int size = 1 << TableBits;
+            constexpr static V amplitude = numeric_limits<V>::max();
+
+            V values[size + 2];
+
+            constexpr sine_table() : values() {
+                for (int i = 0; i <= size; ++i) {
+                    double s = sin_taylor(1.57079632679489661923 * i / size) * amplitude;
+                    values[i] = static_cast<V>(s + 0.5);
+                }
+                values[size + 1] = values[size - 1];
+            }
+        };
+
+        template <typename V, int TableBits>
+        constexpr sine_table<V, TableBits> sine_table_v{};
+    }  // namespace detail
+
+    template <typename T>
+    class binary_angle {
+        static_assert(numeric_limits<T>::is_integer && !numeric_limits<T>::is_signed,
+            "binary_angle requires an unsigned integer type");
+        static_assert(numeric_limits<T>::digits <= 32, "binary_angle supports at most 32 bits");
+
+    public:
+        using value_type = T;
+        using units = ctd::units::radian;
+
+        constexpr static int bits = numeric_limits<T>::digits;
+
+        // The angle of one LSB in radians, i.e. 2*pi/2^bits.
+        using scale = ratio_divide<ratio_multiply<ratio<2>, ratio_pi>, ratio<intmax_t(1) << bits>>;
+
+        constexpr binary_angle() = default;
+        constexpr explicit binary_angle(value_type raw) : v(raw) {}
+
+        // Converts any angle quantity, angles outside of one turn are wrapped.
+        template <typename OtherValueType, typename OtherScale>
+        constexpr binary_angle(const quantity<OtherValueType, units, OtherScale>& q) : v(wrap<OtherScale>(q.count())) {}
+
+        // The angle as a quantity in radians with the LSB of the angle as scale. This requires no computation, use the
+        // quantity conversions to get the angle in any other scale.
+        constexpr quantity<value_type, units, scale> radians() const { return v; }
+
+        // The conversion is computed in intmax_t for integer targets so that 32 bit angles don't overflow.
+        template <typename OtherValueType, typename OtherScale>
+        constexpr operator quantity<OtherValueType, units, OtherScale>() const {
+            using wide = conditional_t<numeric_limits<OtherValueType>::is_integer, intmax_t, OtherValueType>;
+            return static_cast<OtherValueType>(ratio_convert<OtherScale, scale, wide>(v));
+        }
+
+        constexpr value_type count() const { return v; }
+
+        // The angle interpreted as being in [-pi, pi).
+        constexpr detail::bam_signed_t<T> signed_count() const { return static_cast<detail::bam_signed_t<T>>(v); }
+
+        constexpr binary_angle operator-() const { return binary_angle(static_cast<value_type>(-v)); }
+
+        constexpr binary_angle& operator+=(binary_angle rhs) {
+            v = static_cast<value_type>(v + rhs.v);
+            return *this;
+        }
+
+        constexpr binary_angle& operator-=(binary_angle rhs) {
+            v = static_cast<value_type>(v - rhs.v);
+            return *this;
+        }
+
+        friend constexpr binary_angle operator+(binary_angle lhs, binary_angle rhs) { return lhs += rhs; }
+        friend constexpr binary_angle operator-(binary_angle lhs, binary_angle rhs) { return lhs -= rhs; }
+
+        // Multiples of an angle wrap around like its sum with itself, so the product is taken modulo a turn.
+        template <typename S>
+            requires numeric_limits<S>::is_integer
+        friend constexpr binary_angle operator*(binary_angle lhs, S rhs) {
+            return binary_angle(static_cast<value_type>(uintmax_t(lhs.v) * static_cast<uintmax_t>(rhs)));
+        }
+
+        template <typename S>
+            requires numeric_limits<S>::is_integer
+        friend constexpr binary_angle operator*(S lhs, binary_angle rhs) {
+            return rhs * lhs;
+        }
+
+        friend constexpr bool operator==(binary_angle lhs, binary_angle rhs) { return lhs.v == rhs.v; }
+        friend constexpr bool operator!=(binary_angle lhs, binary_angle rhs) { return lhs.v != rhs.v; }
+
+    private:
+        template <typename OtherScale, typename V>
+        constexpr static value_type wrap(V count) {
+            if constexpr (numeric_limits<V>::is_integer) {
+                return static_cast<value_type>(
+                    ratio_convert<scale, OtherScale, intmax_t, float_round_style::round_to_nearest>(count));
+            }
+            else {
+                auto x = ratio_convert<scale, OtherScale, V>(count);
+                return static_cast<value_type>(static_cast<intmax_t>(x < 0 ? x - V(0.5) : x + V(0.5)));
+            }
+        }
+
+        value_type v;
+    };
+
+#ifdef HAS_STL
+    using std::sin;
+    using std::cos;
+#endif
+
+    // Computes sin(a) by linear interpolation in a quarter wave table of 2^TableBits + 2 entries. The result is
+    // exact at multiples of a quarter turn and within a couple of LSB elsewhere.
+    template <int TableBits = 8, typename T>
+    constexpr auto sin(binary_angle<T> a) {
+        using V = detail::bam_trig_t<T>;
+        using result = quantity<V, units::unity, ratio<1, numeric_limits<V>::max()>>;
+
+        constexpr int quarter_bits = binary_angle<T>::bits - 2;
+        constexpr int table_bits = TableBits < quarter_bits ? TableBits : quarter_bits;
+        constexpr int frac_bits = quarter_bits - table_bits;
+        constexpr uint32_t quarter = uint32_t(1) << quarter_bits;
+        constexpr auto& table = detail::sine_table_v<V, table_bits>.values;
+
+        const uint32_t raw = a.count();
+        const uint32_t quadrant = raw >> quarter_bits;
+        const uint32_t phase = raw & (quarter - 1);
+
+        // Position in the quarter wave, mirrored for the second and fourth quadrant.
+        const uint32_t x = (quadrant & 1) ? quarter - phase : phase;
+        const uint32_t index = x >> frac_bits;
+        const int64_t frac = x & ((uint32_t(1) << frac_bits) - 1);
+
+        const int64_t lo = table[index];
+        const int64_t hi = table[index + 1];
+        const auto s = static_cast<V>(lo + (((hi - lo) * frac + (int64_t(1) << frac_bits >> 1)) >> frac_bits));
+        return result(static_cast<V>(quadrant & 2 ? -s : s));
+    }
+
+    template <int TableBits = 8, typename T>
+    constexpr auto cos(binary_angle<T> a) {
+        constexpr auto quarter_turn = binary_angle<T>(static_cast<T>(T(1) << (binary_angle<T>::bits - 2)));
+        return sin<TableBits>(a + quarter_turn);
+    }
+}  // namespace ctd
+
+#endif
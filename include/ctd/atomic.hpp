@@ -0,0 +1,15 @@
+/*
+* This file provides an implementation of <atomic> which is from std:: if HAS_STL is true, and from CTD otherwise.
+*/
+#ifndef CTD_ATOMIC_HPP
+#define CTD_ATOMIC_HPP
+
+#include "stl_switch.hpp"
+
+#ifdef HAS_STL
+#include <atomic>
+#else
+#include "atomic_impl.hpp"
+#endif
+
+#endif // CTD_ATOMIC_HPP
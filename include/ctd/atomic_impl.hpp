@@ -0,0 +1,176 @@
+/**
+* This file provides a partial implementation of <atomic> for systems where STL isn't present.
+*
+* On AVR the operations are made atomic by masking interrupts for their duration, which is sufficient on a single
+* core. Elsewhere the GCC __atomic builtins are used.
+*/
+#ifndef CTD_ATOMIC_IMPL_HPP
+#define CTD_ATOMIC_IMPL_HPP
+
+#ifdef __AVR__
+#include <util/atomic.h>
+#endif
+
+namespace ctd_impl {
+
+    enum class memory_order : int {
+        relaxed = __ATOMIC_RELAXED,
+        consume = __ATOMIC_CONSUME,
+        acquire = __ATOMIC_ACQUIRE,
+        release = __ATOMIC_RELEASE,
+        acq_rel = __ATOMIC_ACQ_REL,
+        seq_cst = __ATOMIC_SEQ_CST
+    };
+
+    inline constexpr memory_order memory_order_relaxed = memory_order::relaxed;
+    inline constexpr memory_order memory_order_consume = memory_order::consume;
+    inline constexpr memory_order memory_order_acquire = memory_order::acquire;
+    inline constexpr memory_order memory_order_release = memory_order::release;
+    inline constexpr memory_order memory_order_acq_rel = memory_order::acq_rel;
+    inline constexpr memory_order memory_order_seq_cst = memory_order::seq_cst;
+
+    inline void atomic_signal_fence(memory_order order) { __atomic_signal_fence(static_cast<int>(order)); }
+
+    inline void atomic_thread_fence(memory_order order) { __atomic_thread_fence(static_cast<int>(order)); }
+
+#ifdef __AVR__
+    // Interrupts are masked for each operation, the asm memory clobbers of the critical section also act as
+    // compiler barriers so the memory order is respected.
+    template <typename T>
+    class atomic {
+    public:
+        atomic() = default;
+        constexpr atomic(T desired) : v(desired) {}
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        static constexpr bool is_always_lock_free = sizeof(T) == 1;
+        bool is_lock_free() const { return is_always_lock_free; }
+
+        T load(memory_order = memory_order_seq_cst) const {
+            T ans;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ans = v; }
+            return ans;
+        }
+
+        void store(T desired, memory_order = memory_order_seq_cst) {
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { v = desired; }
+        }
+
+        T exchange(T desired, memory_order = memory_order_seq_cst) {
+            T ans;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                ans = v;
+                v = desired;
+            }
+            return ans;
+        }
+
+        bool compare_exchange_strong(T& expected, T desired, memory_order = memory_order_seq_cst) {
+            bool ans;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                ans = v == expected;
+                if (ans) {
+                    v = desired;
+                }
+                else {
+                    expected = v;
+                }
+            }
+            return ans;
+        }
+
+        bool compare_exchange_weak(T& expected, T desired, memory_order order = memory_order_seq_cst) {
+            return compare_exchange_strong(expected, desired, order);
+        }
+
+        T fetch_add(T arg, memory_order = memory_order_seq_cst) {
+            T ans;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                ans = v;
+                v = ans + arg;
+            }
+            return ans;
+        }
+
+        T fetch_sub(T arg, memory_order = memory_order_seq_cst) {
+            T ans;
+            ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+                ans = v;
+                v = ans - arg;
+            }
+            return ans;
+        }
+
+        operator T() const { return load(); }
+
+        T operator=(T desired) {
+            store(desired);
+            return desired;
+        }
+
+    private:
+        volatile T v;
+    };
+#else
+    template <typename T>
+    class atomic {
+    public:
+        atomic() = default;
+        constexpr atomic(T desired) : v(desired) {}
+        atomic(const atomic&) = delete;
+        atomic& operator=(const atomic&) = delete;
+
+        static constexpr bool is_always_lock_free = __atomic_always_lock_free(sizeof(T), 0);
+        bool is_lock_free() const { return __atomic_is_lock_free(sizeof(T), &v); }
+
+        T load(memory_order order = memory_order_seq_cst) const { return __atomic_load_n(&v, static_cast<int>(order)); }
+
+        void store(T desired, memory_order order = memory_order_seq_cst) {
+            __atomic_store_n(&v, desired, static_cast<int>(order));
+        }
+
+        T exchange(T desired, memory_order order = memory_order_seq_cst) {
+            return __atomic_exchange_n(&v, desired, static_cast<int>(order));
+        }
+
+        bool compare_exchange_strong(T& expected, T desired, memory_order order = memory_order_seq_cst) {
+            return __atomic_compare_exchange_n(&v, &expected, desired, false, static_cast<int>(order),
+                failure_order(order));
+        }
+
+        bool compare_exchange_weak(T& expected, T desired, memory_order order = memory_order_seq_cst) {
+            return __atomic_compare_exchange_n(&v, &expected, desired, true, static_cast<int>(order),
+                failure_order(order));
+        }
+
+        T fetch_add(T arg, memory_order order = memory_order_seq_cst) {
+            return __atomic_fetch_add(&v, arg, static_cast<int>(order));
+        }
+
+        T fetch_sub(T arg, memory_order order = memory_order_seq_cst) {
+            return __atomic_fetch_sub(&v, arg, static_cast<int>(order));
+        }
+
+        operator T() const { return load(); }
+
+        T operator=(T desired) {
+            store(desired);
+            return desired;
+        }
+
+    private:
+        // The failure order of a compare exchange may not be a release order.
+        static constexpr int failure_order(memory_order order) {
+            return order == memory_order_acq_rel ? __ATOMIC_ACQUIRE
+                : order == memory_order_release ? __ATOMIC_RELAXED
+                : static_cast<int>(order);
+        }
+
+        T v;
+    };
+#endif
+
+}  // namespace ctd_impl
+
+#endif
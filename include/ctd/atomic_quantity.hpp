@@ -0,0 +1,108 @@
+/*
+* This file provides an atomic quantity, for readings and counters that are shared between interrupt handlers or
+* threads. Only the raw count is stored atomically, the units and scale are part of the type. On AVR, where atomics
+* aren't native, each operation is a short section with interrupts masked, see atomic_impl.hpp.
+*/
+#ifndef CTD_ATOMIC_QUANTITY_HPP
+#define CTD_ATOMIC_QUANTITY_HPP
+
+#include "atomic.hpp"
+#include "limits.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    template <typename Q>
+    class atomic_quantity {
+        static_assert(is_quantity_v<Q>, "atomic_quantity requires a quantity");
+
+    public:
+        using value_type = Q;
+        using count_type = typename Q::value_type;
+        using units = typename Q::units;
+        using scale = typename Q::scale;
+
+        static constexpr bool is_always_lock_free = atomic<count_type>::is_always_lock_free;
+
+        atomic_quantity() = default;
+        constexpr atomic_quantity(Q desired) : v(desired.count()) {}
+        atomic_quantity(const atomic_quantity&) = delete;
+        atomic_quantity& operator=(const atomic_quantity&) = delete;
+
+        bool is_lock_free() const { return v.is_lock_free(); }
+
+        Q load(memory_order order = memory_order_seq_cst) const { return Q(v.load(order)); }
+
+        void store(Q desired, memory_order order = memory_order_seq_cst) { v.store(desired.count(), order); }
+
+        Q exchange(Q desired, memory_order order = memory_order_seq_cst) {
+            return Q(v.exchange(desired.count(), order));
+        }
+
+        bool compare_exchange_strong(Q& expected, Q desired, memory_order order = memory_order_seq_cst) {
+            count_type e = expected.count();
+            const bool ans = v.compare_exchange_strong(e, desired.count(), order);
+            expected = Q(e);
+            return ans;
+        }
+
+        bool compare_exchange_weak(Q& expected, Q desired, memory_order order = memory_order_seq_cst) {
+            count_type e = expected.count();
+            const bool ans = v.compare_exchange_weak(e, desired.count(), order);
+            expected = Q(e);
+            return ans;
+        }
+
+        // Adds a quantity of the same units and any scale, returns the previous value. The argument is converted to
+        // the scale of Q, rounding toward zero, before the read-modify-write, so the conversion factor is a
+        // compile time constant and the atomic section is a single add. Accumulate fine increments into a counter
+        // with a scale at least as fine, or the truncated remainders are lost.
+        template <typename ValueType, typename Scale>
+        Q fetch_add(const quantity<ValueType, units, Scale>& arg, memory_order order = memory_order_seq_cst) {
+            return Q(add(Q(arg).count(), order));
+        }
+
+        template <typename ValueType, typename Scale>
+        Q fetch_sub(const quantity<ValueType, units, Scale>& arg, memory_order order = memory_order_seq_cst) {
+            return Q(add(static_cast<count_type>(-Q(arg).count()), order));
+        }
+
+        template <typename ValueType, typename Scale>
+        Q operator+=(const quantity<ValueType, units, Scale>& arg) {
+            const count_type delta = Q(arg).count();
+            return Q(static_cast<count_type>(add(delta, memory_order_seq_cst) + delta));
+        }
+
+        template <typename ValueType, typename Scale>
+        Q operator-=(const quantity<ValueType, units, Scale>& arg) {
+            const count_type delta = static_cast<count_type>(-Q(arg).count());
+            return Q(static_cast<count_type>(add(delta, memory_order_seq_cst) + delta));
+        }
+
+        operator Q() const { return load(); }
+
+        Q operator=(Q desired) {
+            store(desired);
+            return desired;
+        }
+
+    private:
+        count_type add(count_type delta, memory_order order) {
+            if constexpr (numeric_limits<count_type>::is_integer) {
+                return v.fetch_add(delta, order);
+            }
+            else {
+                // There is no floating point fetch_add without the standard library, a compare exchange loop works
+                // everywhere.
+                count_type old = v.load(memory_order_relaxed);
+                while (!v.compare_exchange_weak(old, static_cast<count_type>(old + delta), order)) {
+                }
+                return old;
+            }
+        }
+
+        atomic<count_type> v;
+    };
+}  // namespace ctd
+
+#endif
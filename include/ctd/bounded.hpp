@@ -0,0 +1,242 @@
+/*
+* This file provides range tracked quantities. A bounded_quantity carries the minimum and maximum value of its count
+* as template arguments. The bounds are propagated through arithmetic using interval arithmetic, and every result is
+* stored in the smallest integer type that provably can hold it. Results can thus not overflow, and on 8-bit cores
+* the computations stay as narrow as the values allow.
+*/
+#ifndef CTD_BOUNDED_HPP
+#define CTD_BOUNDED_HPP
+
+#include <cstdint>
+
+#include "limits.hpp"
+#include "numeric.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // The smallest integer type that can hold every value in [Min, Max]. Unsigned types are preferred when the
+        // range is non-negative.
+        template <intmax_t Min, intmax_t Max>
+        using least_int_t = conditional_t<(Min >= 0),
+            conditional_t<(Max <= UINT8_MAX), uint8_t,
+            conditional_t<(Max <= UINT16_MAX), uint16_t,
+            conditional_t<(Max <= UINT32_MAX), uint32_t, uint64_t>>>,
+            conditional_t<(Min >= INT8_MIN && Max <= INT8_MAX), int8_t,
+            conditional_t<(Min >= INT16_MIN && Max <= INT16_MAX), int16_t,
+            conditional_t<(Min >= INT32_MIN && Max <= INT32_MAX), int32_t, int64_t>>>>;
+
+        // The type an operator computes in, which holds every value in [Min, Max]. Unsigned types are widened to at
+        // least unsigned int, narrower ones would be promoted to int, where their product can overflow.
+        template <intmax_t Min, intmax_t Max>
+        using bounded_arith_t =
+            conditional_t<(Min >= 0), decltype(least_int_t<Min, Max>() + 0u), least_int_t<Min, Max>>;
+
+        constexpr intmax_t min4(intmax_t a, intmax_t b, intmax_t c, intmax_t d) {
+            intmax_t ab = a < b ? a : b;
+            intmax_t cd = c < d ? c : d;
+            return ab < cd ? ab : cd;
+        }
+
+        constexpr intmax_t max4(intmax_t a, intmax_t b, intmax_t c, intmax_t d) {
+            intmax_t ab = a > b ? a : b;
+            intmax_t cd = c > d ? c : d;
+            return ab > cd ? ab : cd;
+        }
+
+        // The largest scale that both scales are integer multiples of, i.e. gcd(a, c) / lcm(b, d).
+        template <typename scale_l, typename scale_r>
+        using common_scale = typename ratio<gcd(scale_l::num, scale_r::num),
+            scale_l::den / gcd(scale_l::den, scale_r::den) * scale_r::den>::type;
+
+        // The integer factor that a count in 'from' must be multiplied with to be expressed in 'to'.
+        template <typename from, typename to>
+        constexpr intmax_t scale_factor = ratio_divide<from, to>::num;
+    }  // namespace detail
+
+    template <intmax_t Min, intmax_t Max, typename Units, typename Scale = ratio<1>>
+    class bounded_quantity {
+        static_assert(Min <= Max, "The lower bound must not be above the upper bound");
+
+    public:
+        using units = Units;
+        using scale = Scale;
+        using value_type = detail::least_int_t<Min, Max>;
+
+        constexpr static intmax_t min = Min;
+        constexpr static intmax_t max = Max;
+
+        constexpr bounded_quantity() = default;
+
+        // The value must be within [Min, Max], use clamped() for values that aren't known to be.
+        constexpr explicit bounded_quantity(value_type val) : v(val) {}
+
+        // Widening from a quantity whose bounds are within ours.
+        template <intmax_t OtherMin, intmax_t OtherMax>
+            requires(OtherMin >= Min && OtherMax <= Max)
+        constexpr bounded_quantity(const bounded_quantity<OtherMin, OtherMax, Units, Scale>& q)
+            : v(static_cast<value_type>(q.count())) {}
+
+        // Saturates any value into [Min, Max].
+        template <typename T>
+        constexpr static bounded_quantity clamped(T val) {
+            if constexpr (numeric_limits<T>::is_signed) {
+                if (intmax_t(val) < Min) {
+                    return bounded_quantity(static_cast<value_type>(Min));
+                }
+                if (intmax_t(val) > Max) {
+                    return bounded_quantity(static_cast<value_type>(Max));
+                }
+            }
+            else {
+                if (Max < 0 || uintmax_t(val) > uintmax_t(Max)) {
+                    return bounded_quantity(static_cast<value_type>(Max));
+                }
+                if (Min > 0 && uintmax_t(val) < uintmax_t(Min)) {
+                    return bounded_quantity(static_cast<value_type>(Min));
+                }
+            }
+            return bounded_quantity(static_cast<value_type>(val));
+        }
+
+        template <typename T>
+        constexpr static bounded_quantity clamped(const quantity<T, Units, Scale>& q) {
+            return clamped(q.count());
+        }
+
+        constexpr value_type count() const { return v; }
+
+        constexpr quantity<value_type, Units, Scale> as_quantity() const { return v; }
+
+        template <typename OtherValueType, typename OtherScale>
+        constexpr operator quantity<OtherValueType, Units, OtherScale>() const {
+            return quantity<OtherValueType, Units, OtherScale>(as_quantity());
+        }
+
+        constexpr bounded_quantity<-Max, -Min, Units, Scale> operator-() const {
+            using result = bounded_quantity<-Max, -Min, Units, Scale>;
+            return result(static_cast<typename result::value_type>(-v));
+        }
+
+    private:
+        value_type v;
+    };
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr auto operator+(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        using scale = detail::common_scale<scale_l, scale_r>;
+        constexpr intmax_t a = detail::scale_factor<scale_l, scale>;
+        constexpr intmax_t b = detail::scale_factor<scale_r, scale>;
+
+        constexpr intmax_t lo = min_l * a + min_r * b;
+        constexpr intmax_t hi = max_l * a + max_r * b;
+
+        using result = bounded_quantity<lo, hi, units, scale>;
+        // Holds the operands, which are between zero and the scaled operands, as well as the sum.
+        using W = detail::bounded_arith_t<detail::min4(0, min_l * a, min_r * b, lo),
+            detail::max4(0, max_l * a, max_r * b, hi)>;
+        return result(static_cast<typename result::value_type>(W(lhs.count()) * W(a) + W(rhs.count()) * W(b)));
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr auto operator-(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        using scale = detail::common_scale<scale_l, scale_r>;
+        constexpr intmax_t a = detail::scale_factor<scale_l, scale>;
+        constexpr intmax_t b = detail::scale_factor<scale_r, scale>;
+
+        constexpr intmax_t lo = min_l * a - max_r * b;
+        constexpr intmax_t hi = max_l * a - min_r * b;
+
+        using result = bounded_quantity<lo, hi, units, scale>;
+        using W = detail::bounded_arith_t<detail::min4(0, min_l * a, min_r * b, lo),
+            detail::max4(0, max_l * a, max_r * b, hi)>;
+        return result(static_cast<typename result::value_type>(W(lhs.count()) * W(a) - W(rhs.count()) * W(b)));
+    }
+
+    template <intmax_t min_l, intmax_t max_l, typename units_l, typename scale_l, intmax_t min_r, intmax_t max_r,
+        typename units_r, typename scale_r>
+    constexpr auto operator*(const bounded_quantity<min_l, max_l, units_l, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units_r, scale_r>& rhs) {
+        constexpr intmax_t lo = detail::min4(min_l * min_r, min_l * max_r, max_l * min_r, max_l * max_r);
+        constexpr intmax_t hi = detail::max4(min_l * min_r, min_l * max_r, max_l * min_r, max_l * max_r);
+
+        using result = bounded_quantity<lo, hi, units::detail::unit_powers_add<units_l, units_r>,
+            ratio_multiply<scale_l, scale_r>>;
+        using W = detail::bounded_arith_t<detail::min4(0, min_l, min_r, lo), detail::max4(0, max_l, max_r, hi)>;
+        return result(static_cast<typename result::value_type>(W(lhs.count()) * W(rhs.count())));
+    }
+
+    // Integer division, truncating toward zero. The divisor's range must not include zero.
+    template <intmax_t min_l, intmax_t max_l, typename units_l, typename scale_l, intmax_t min_r, intmax_t max_r,
+        typename units_r, typename scale_r>
+    constexpr auto operator/(const bounded_quantity<min_l, max_l, units_l, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units_r, scale_r>& rhs) {
+        static_assert(min_r > 0 || max_r < 0, "The range of the divisor includes zero");
+
+        constexpr intmax_t lo = detail::min4(min_l / min_r, min_l / max_r, max_l / min_r, max_l / max_r);
+        constexpr intmax_t hi = detail::max4(min_l / min_r, min_l / max_r, max_l / min_r, max_l / max_r);
+
+        // The division needs a type that holds both operands, the quotient is never larger than the dividend.
+        using T = detail::least_int_t<(min_l < min_r ? min_l : min_r), (max_l > max_r ? max_l : max_r)>;
+        using result = bounded_quantity<lo, hi, units::detail::unit_powers_subtract<units_l, units_r>,
+            ratio_divide<scale_l, scale_r>>;
+        using V = typename result::value_type;
+        return result(static_cast<V>(static_cast<T>(lhs.count()) / static_cast<T>(rhs.count())));
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr bool operator==(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        return (lhs - rhs).count() == 0;
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr bool operator<(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        return (lhs - rhs).count() < 0;
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr bool operator>(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        return rhs < lhs;
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr bool operator<=(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        return !(rhs < lhs);
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr bool operator>=(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        return !(lhs < rhs);
+    }
+
+    template <intmax_t min_l, intmax_t max_l, intmax_t min_r, intmax_t max_r, typename units, typename scale_l,
+        typename scale_r>
+    constexpr bool operator!=(const bounded_quantity<min_l, max_l, units, scale_l>& lhs,
+        const bounded_quantity<min_r, max_r, units, scale_r>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    //
+    // Convenience alias for a bounded quantity with the same units and scale as an existing quantity type.
+    //
+    template <typename Quantity, intmax_t Min, intmax_t Max>
+    using bounded = bounded_quantity<Min, Max, typename Quantity::units, typename Quantity::scale>;
+}  // namespace ctd
+
+#endif
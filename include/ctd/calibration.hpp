@@ -0,0 +1,185 @@
+/*
+* This file provides calibration polynomials, y = c0 + c1*x + c2*x^2 + ..., with coefficients that are exact quantity
+* constants. The units are checked at compile time, and for integer quantities every rescale between the input, the
+* coefficients and the output is folded into the coefficients during compilation. Evaluation is then Horner's scheme
+* in fixed point with one multiply, one shift and one add per coefficient, and the result is bit identical on every
+* platform.
+*/
+#ifndef CTD_CALIBRATION_HPP
+#define CTD_CALIBRATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // An exact constant of Count * Scale in Units, e.g. coefficient<39083, ohm_per_kelvin, ratio<1, 100000>> for
+    // 0.39083 ohm/K.
+    template <intmax_t Count, typename Units, typename Scale = ratio<1>>
+    struct coefficient {
+        using units = Units;
+        using scale = Scale;
+        constexpr static intmax_t count = Count;
+    };
+
+    namespace detail {
+        // The coefficient as a factor on counts: c_k * in_scale^k / out_scale.
+        template <typename Coefficient, size_t K, typename Input, typename Output>
+        using count_factor = ratio_divide<ratio_multiply<ratio_multiply<ratio<Coefficient::count>,
+            typename Coefficient::scale>, typename ratio_power<typename Input::scale, int(K)>::type>,
+            typename Output::scale>;
+
+        // Walks the coefficients with their power K.
+        template <typename Input, typename Output, size_t K, typename... Coefficients>
+        struct coefficient_table {
+            constexpr static bool units_match = true;
+            constexpr static void fill(intmax_t*, intmax_t*) {}
+        };
+
+        template <typename Input, typename Output, size_t K, typename Coefficient, typename... Rest>
+        struct coefficient_table<Input, Output, K, Coefficient, Rest...> {
+            using factor = count_factor<Coefficient, K, Input, Output>;
+            using next = coefficient_table<Input, Output, K + 1, Rest...>;
+
+            constexpr static bool units_match = is_same_v<typename Coefficient::units,
+                ctd::units::detail::unit_powers_subtract<typename Output::units,
+                    ctd::units::detail::unit_powers_multiply<typename Input::units, int(K)>>> && next::units_match;
+
+            constexpr static void fill(intmax_t* num, intmax_t* den) {
+                num[K] = factor::num;
+                den[K] = factor::den;
+                next::fill(num, den);
+            }
+        };
+
+        // The coefficients as fixed point numbers for Horner's scheme. The accumulator after step k is bounded by
+        //   B_k = |c_k| + X * B_k+1
+        // where X is the largest input magnitude. Each step gets as many fraction bits as possible such that
+        // B_k * growth still fits in the accumulator, where growth is X if the next multiplication is done in the
+        // accumulator type and 1 if it is done in a wider type. This makes the fraction bits non-increasing towards
+        // c_0, and every step is a multiply followed by a right shift.
+        template <typename Table, size_t N>
+        struct horner_plan {
+            intmax_t num[N];
+            intmax_t den[N];
+            int bits[N];
+            intmax_t fixed[N];
+            // False if even without fraction bits an intermediate can overflow the accumulator.
+            bool fits;
+
+            // 'digits' is the number of value bits of the accumulator. One bit is left for adding c_k.
+            constexpr horner_plan(double max_input, double growth, int digits)
+                : num(), den(), bits(), fixed(), fits(true) {
+                Table::fill(num, den);
+                const double limit = double(intmax_t(1) << (digits - 1));
+                double bound = 0;
+                for (size_t i = N; i-- > 0;) {
+                    bound = (num[i] < 0 ? -double(num[i]) : double(num[i])) / double(den[i]) + max_input * bound;
+                    if (bound * growth >= limit) {
+                        fits = false;
+                    }
+                    int b = 0;
+                    while (b < digits - 1 && bound * growth * double(intmax_t(1) << (b + 1)) < limit) {
+                        ++b;
+                    }
+                    bits[i] = b;
+                    fixed[i] = fixed_point_round(num[i], den[i], b);
+                }
+            }
+        };
+    }  // namespace detail
+
+    // Evaluates a polynomial with the given coefficients, in ascending order of power, on Input quantities. The units
+    // of the k-th coefficient must be the Output units divided by the Input units to the power k. Integer
+    // evaluation uses Accumulator, a signed integer type, for the fixed point intermediates.
+    template <typename Input, typename Output, typename Accumulator, typename... Coefficients>
+    class basic_calibration_polynomial {
+        static_assert(sizeof...(Coefficients) > 0, "A polynomial needs at least one coefficient");
+        static_assert(numeric_limits<Accumulator>::is_signed, "The accumulator must be signed");
+
+        using table = detail::coefficient_table<Input, Output, 0, Coefficients...>;
+        static_assert(table::units_match, "The units of a coefficient don't match the units of the input and output");
+
+        constexpr static size_t degree = sizeof...(Coefficients) - 1;
+
+        using in_type = typename Input::value_type;
+        using out_type = typename Output::value_type;
+        constexpr static bool integer = numeric_limits<in_type>::is_integer && numeric_limits<out_type>::is_integer;
+        using float_type = conditional_t<numeric_limits<out_type>::is_integer, in_type, out_type>;
+
+        // Only the integer evaluation needs the bound, the floating point evaluation only uses the exact factors.
+        constexpr static double max_input() {
+            if (!integer) {
+                return 1;
+            }
+            const double lo = double(numeric_limits<in_type>::lowest());
+            const double hi = double(numeric_limits<in_type>::max());
+            return -lo > hi ? -lo : hi;
+        }
+
+        // Narrow accumulators multiply into a 64 bit product, which is a single instruction on 32 bit cores, and
+        // then need no headroom for the multiplication.
+        using product_type = conditional_t<(numeric_limits<Accumulator>::digits < 32 &&
+            numeric_limits<in_type>::digits <= 32), int64_t, Accumulator>;
+        constexpr static bool wide_product = !is_same_v<product_type, Accumulator>;
+
+        constexpr static detail::horner_plan<table, degree + 1> plan{ max_input(), wide_product ? 1 : max_input(),
+            numeric_limits<Accumulator>::digits };
+        static_assert(!integer || plan.fits, "The polynomial can overflow the accumulator even without fraction bits");
+
+        template <size_t K>
+        constexpr static Accumulator horner(Accumulator x, Accumulator acc) {
+            if constexpr (K == 0) {
+                return acc;
+            }
+            else {
+                constexpr int shift = plan.bits[K] - plan.bits[K - 1];
+                constexpr auto c = static_cast<Accumulator>(plan.fixed[K - 1]);
+                return horner<K - 1>(x, static_cast<Accumulator>(((product_type(acc) * x) >> shift) + c));
+            }
+        }
+
+    public:
+        using input_type = Input;
+        using output_type = Output;
+
+        constexpr static Output evaluate(Input x) {
+            if constexpr (integer) {
+                const auto acc = horner<degree>(Accumulator(x.count()), static_cast<Accumulator>(plan.fixed[degree]));
+                constexpr int bits = plan.bits[0];
+                if constexpr (bits == 0) {
+                    return static_cast<out_type>(acc);
+                }
+                else {
+                    return static_cast<out_type>((acc + (Accumulator(1) << (bits - 1))) >> bits);
+                }
+            }
+            else {
+                const auto v = static_cast<float_type>(x.count());
+                float_type acc = 0;
+                for (size_t i = degree + 1; i-- > 0;) {
+                    acc = acc * v + float_type(plan.num[i]) / float_type(plan.den[i]);
+                }
+                if constexpr (numeric_limits<out_type>::is_integer) {
+                    return static_cast<out_type>(acc < 0 ? acc - float_type(0.5) : acc + float_type(0.5));
+                }
+                else {
+                    return static_cast<out_type>(acc);
+                }
+            }
+        }
+
+        constexpr Output operator()(Input x) const { return evaluate(x); }
+    };
+
+    // A calibration polynomial with a 64 bit accumulator. basic_calibration_polynomial with int32_t is usually as
+    // precise for 16 bit inputs and faster on 32 bit cores, as it only needs a 32x32->64 bit multiplication.
+    template <typename Input, typename Output, typename... Coefficients>
+    using calibration_polynomial = basic_calibration_polynomial<Input, Output, int64_t, Coefficients...>;
+}  // namespace ctd
+
+#endif
@@ -0,0 +1,65 @@
+/*
+* This file provides a clock on top of a free-running timer counter. Time points and durations are kept in raw timer
+* ticks, typed as time<> quantities with the tick period as scale. Measuring an interval is then one subtraction and
+* nothing is rescaled until the duration is converted to another time quantity.
+*/
+#ifndef CTD_CLOCK_HPP
+#define CTD_CLOCK_HPP
+
+#include <cstdint>
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // A clock counting at TimerHz. Counter must provide a static read() function returning the current value of
+    // the counter as an unsigned integer that wraps around at its maximum value. This can be a hardware timer
+    // register or a simulated counter in host tests.
+    template <intmax_t TimerHz, typename Counter>
+    class tick_clock {
+    public:
+        using rep = decltype(Counter::read());
+        using period = ratio<1, TimerHz>;
+        using duration = time<rep, period>;
+
+        static_assert(!numeric_limits<rep>::is_signed, "The counter must be unsigned to wrap around");
+
+        class time_point {
+        public:
+            constexpr time_point() = default;
+            constexpr explicit time_point(rep ticks) : t(ticks) {}
+
+            constexpr rep ticks() const { return t; }
+
+            // The time since 'earlier'. This is correct across a counter wrap-around as long as the interval is
+            // shorter than the counter period.
+            constexpr duration operator-(time_point earlier) const {
+                return duration(static_cast<rep>(t - earlier.t));
+            }
+
+            constexpr time_point operator+(duration d) const { return time_point(static_cast<rep>(t + d.count())); }
+
+            constexpr time_point operator-(duration d) const { return time_point(static_cast<rep>(t - d.count())); }
+
+            constexpr bool operator==(time_point rhs) const { return t == rhs.t; }
+
+            constexpr bool operator!=(time_point rhs) const { return t != rhs.t; }
+
+        private:
+            rep t;
+        };
+
+        static time_point now() { return time_point(Counter::read()); }
+
+        static duration elapsed_since(time_point start) { return now() - start; }
+
+        // True if 'deadline' is at or before 'current', assuming the two are less than half a counter period apart.
+        constexpr static bool reached(time_point deadline, time_point current) {
+            constexpr rep half = static_cast<rep>(rep(~rep(0)) / 2 + 1);
+            return static_cast<rep>(current.ticks() - deadline.ticks()) < half;
+        }
+    };
+}  // namespace ctd
+
+#endif
@@ -13,7 +13,20 @@
 #include "cmath_impl.hpp"
 #endif
 
+#include <cstdint>
+
+#include "limits.hpp"
+#include "type_traits.hpp"
+
 namespace ctd {
+    enum class round_style { nearest, truncate, floor, ceil };
+
+    namespace detail {
+        template <typename T>
+        using unsigned_of = conditional_t<sizeof(T) == 1, uint8_t,
+            conditional_t<sizeof(T) == 2, uint16_t,
+            conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+    }  // namespace detail
 
     template <typename T>
     constexpr auto sign(T v) {
@@ -46,6 +59,54 @@ namespace ctd {
             return num / den;
         }
     }
+
+    // Computes floor(sqrt(v)) of an integer with the bit-by-bit method, which only uses shifts, adds and compares.
+    // Negative values give 0.
+    template <typename T>
+    constexpr T isqrt(T v) {
+        using U = detail::unsigned_of<T>;
+        if (v <= 0) {
+            return 0;
+        }
+
+        U x = static_cast<U>(v);
+        U res = 0;
+        U bit = U(1) << (8 * sizeof(U) - 2);
+        while (bit > x) {
+            bit >>= 2;
+        }
+
+        while (bit != 0) {
+            if (x >= res + bit) {
+                x -= res + bit;
+                res = (res >> 1) + bit;
+            }
+            else {
+                res >>= 1;
+            }
+            bit >>= 2;
+        }
+        return static_cast<T>(res);
+    }
+
+    // Computes the integer cube root of v, rounded toward zero, with the bit-by-bit method.
+    template <typename T>
+    constexpr T icbrt(T v) {
+        using U = detail::unsigned_of<T>;
+        const bool negative = v < 0;
+
+        U x = negative ? static_cast<U>(U(0) - static_cast<U>(v)) : static_cast<U>(v);
+        U y = 0;
+        for (int s = (8 * sizeof(U) - 1) / 3 * 3; s >= 0; s -= 3) {
+            y = 2 * y;
+            U b = 3 * y * (y + 1) + 1;
+            if ((x >> s) >= b) {
+                x -= b << s;
+                ++y;
+            }
+        }
+        return negative ? static_cast<T>(-static_cast<T>(y)) : static_cast<T>(y);
+    }
 }
 
 #endif
\ No newline at end of file
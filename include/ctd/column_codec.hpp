@@ -0,0 +1,384 @@
+/*
+* This file provides a columnar codec for series of integer quantities, such as logged samples. Each block of up to
+* 128 samples stores the units and scale once, the first count, and the rest as zigzag encoded deltas (or deltas of
+* deltas) bit-packed at the width of the largest one. Blocks are independent, so they can be decoded at random given
+* their offsets, and they decode straight into quantity values. Unpacking uses SSE2 or NEON where available.
+*
+* Block layout, all multi-byte fields little-endian:
+*   byte 0      bits: the packed width, 0 to 64, with the order (1 or 2) - 1 in the high bit
+*   byte 1      the number of samples, 1 to 128
+*   bytes 2-5   the exponents of ampere, kelvin, second, metre, kilogram, candela, mole as signed nibbles
+*   varints     zigzag scale::num, scale::den, zigzag first count and, for order 2, zigzag first delta
+*   words       128 residuals in 4 interleaved lanes of 32 values: min(bits, 32) uint32 words per lane for the low
+*               bits, then bits - 32 words per lane for the high bits of wider residuals
+*/
+#ifndef CTD_COLUMN_CODEC_HPP
+#define CTD_COLUMN_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(HAS_STL) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CTD_COLUMN_CODEC_SSE2
+#elif defined(HAS_STL) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CTD_COLUMN_CODEC_NEON
+#endif
+
+#include "limits.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // The prediction that residuals are taken against: the previous sample, or the previous sample plus the previous
+    // delta, which suits ramps such as time stamps and counters.
+    enum class delta_order : uint8_t { delta = 1, delta_of_delta = 2 };
+
+    namespace detail {
+        inline constexpr size_t codec_block = 128;
+        inline constexpr size_t codec_lanes = 4;
+        inline constexpr size_t codec_lane_values = codec_block / codec_lanes;
+        // Two fixed bytes, four bytes of nibbles and up to four varints of at most 10 bytes.
+        constexpr size_t codec_max_header = 2 + 4 + 4 * 10;
+
+        constexpr uint64_t zigzag(uint64_t v) { return (v << 1) ^ (0 - (v >> 63)); }
+        constexpr uint64_t unzigzag(uint64_t v) { return (v >> 1) ^ (0 - (v & 1)); }
+
+        inline uint8_t* put_varint(uint8_t* p, uint64_t v) {
+            while (v >= 0x80) {
+                *p++ = static_cast<uint8_t>(v | 0x80);
+                v >>= 7;
+            }
+            *p++ = static_cast<uint8_t>(v);
+            return p;
+        }
+
+        // Reads no further than 'end'. Returns nullptr if the varint is longer than 64 bits or runs past 'end'.
+        inline const uint8_t* get_varint(const uint8_t* p, const uint8_t* end, uint64_t& v) {
+            v = 0;
+            for (int shift = 0; shift < 64 && p < end; shift += 7) {
+                const uint8_t b = *p++;
+                v |= uint64_t(b & 0x7F) << shift;
+                if (!(b & 0x80)) {
+                    return p;
+                }
+            }
+            return nullptr;
+        }
+
+        inline void put_le32(uint8_t* p, uint32_t v) {
+            p[0] = static_cast<uint8_t>(v);
+            p[1] = static_cast<uint8_t>(v >> 8);
+            p[2] = static_cast<uint8_t>(v >> 16);
+            p[3] = static_cast<uint8_t>(v >> 24);
+        }
+
+        inline uint32_t get_le32(const uint8_t* p) {
+            return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+        }
+
+        template <typename Units>
+        constexpr int unit_exponent(int i) {
+            const int e[] = { Units::ampere, Units::kelvin, Units::second, Units::metre, Units::kilogram,
+                Units::candela, Units::mole };
+            return e[i];
+        }
+
+        template <typename Units>
+        constexpr bool nibble_units() {
+            for (int i = 0; i < 7; ++i) {
+                if (unit_exponent<Units>(i) < -8 || unit_exponent<Units>(i) > 7) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // The units as seven signed nibbles, the eighth is zero.
+        template <typename Units>
+        constexpr uint32_t packed_units() {
+            uint32_t ans = 0;
+            for (int i = 0; i < 7; ++i) {
+                ans |= uint32_t(unit_exponent<Units>(i) & 0xF) << (4 * i);
+            }
+            return ans;
+        }
+
+        constexpr size_t packed_words(int bits) { return codec_lanes * size_t(bits); }
+
+        // Packs 'bits' low bits of each of the 128 values, value i goes to lane i % 4.
+        inline uint8_t* pack_lanes(const uint32_t* in, int bits, uint8_t* out) {
+            for (size_t lane = 0; lane < codec_lanes; ++lane) {
+                uint64_t acc = 0;
+                int filled = 0;
+                size_t word = 0;
+                for (size_t v = 0; v < codec_lane_values; ++v) {
+                    const uint64_t mask = bits == 32 ? 0xFFFFFFFFu : (uint64_t(1) << bits) - 1;
+                    acc |= (in[v * codec_lanes + lane] & mask) << filled;
+                    filled += bits;
+                    if (filled >= 32) {
+                        put_le32(out + 4 * (word++ * codec_lanes + lane), static_cast<uint32_t>(acc));
+                        acc >>= 32;
+                        filled -= 32;
+                    }
+                }
+            }
+            return out + 4 * packed_words(bits);
+        }
+
+        inline void unpack_lanes_scalar(const uint8_t* in, int bits, uint32_t* out) {
+            const uint32_t mask = bits == 32 ? 0xFFFFFFFFu : (uint32_t(1) << bits) - 1;
+            for (size_t lane = 0; lane < codec_lanes; ++lane) {
+                for (size_t v = 0; v < codec_lane_values; ++v) {
+                    const size_t offset = v * size_t(bits);
+                    const size_t k = offset / 32;
+                    const int s = int(offset % 32);
+                    uint32_t x = get_le32(in + 4 * (k * codec_lanes + lane)) >> s;
+                    if (s + bits > 32) {
+                        x |= get_le32(in + 4 * ((k + 1) * codec_lanes + lane)) << (32 - s);
+                    }
+                    out[v * codec_lanes + lane] = x & mask;
+                }
+            }
+        }
+
+#if defined(CTD_COLUMN_CODEC_SSE2)
+        // Four values per iteration, one from each lane, so every shift and mask is the same for the whole register.
+        inline void unpack_lanes(const uint8_t* in, int bits, uint32_t* out) {
+            const __m128i mask = _mm_set1_epi32(bits == 32 ? -1 : int32_t((uint32_t(1) << bits) - 1));
+            for (size_t v = 0; v < codec_lane_values; ++v) {
+                const size_t offset = v * size_t(bits);
+                const size_t k = offset / 32;
+                const int s = int(offset % 32);
+                __m128i x = _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * k)),
+                    _mm_cvtsi32_si128(s));
+                if (s + bits > 32) {
+                    const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * (k + 1)));
+                    x = _mm_or_si128(x, _mm_sll_epi32(next, _mm_cvtsi32_si128(32 - s)));
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + v * codec_lanes), _mm_and_si128(x, mask));
+            }
+        }
+#elif defined(CTD_COLUMN_CODEC_NEON)
+        // As the SSE2 version, vshlq with a negative count shifts right.
+        inline void unpack_lanes(const uint8_t* in, int bits, uint32_t* out) {
+            const uint32x4_t mask = vdupq_n_u32(bits == 32 ? 0xFFFFFFFFu : (uint32_t(1) << bits) - 1);
+            for (size_t v = 0; v < codec_lane_values; ++v) {
+                const size_t offset = v * size_t(bits);
+                const size_t k = offset / 32;
+                const int s = int(offset % 32);
+                uint32x4_t x = vshlq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(in + 16 * k)), vdupq_n_s32(-s));
+                if (s + bits > 32) {
+                    x = vorrq_u32(x, vshlq_u32(vld1q_u32(reinterpret_cast<const uint32_t*>(in + 16 * (k + 1))),
+                        vdupq_n_s32(32 - s)));
+                }
+                vst1q_u32(out + v * codec_lanes, vandq_u32(x, mask));
+            }
+        }
+#else
+        inline void unpack_lanes(const uint8_t* in, int bits, uint32_t* out) { unpack_lanes_scalar(in, bits, out); }
+#endif
+
+        // A block of constant samples, or of a constant slope with delta_of_delta, has no packed words at all.
+        inline void unpack(const uint8_t* in, int bits, uint32_t* out) {
+            if (bits == 0) {
+                for (size_t i = 0; i < codec_block; ++i) {
+                    out[i] = 0;
+                }
+            }
+            else {
+                unpack_lanes(in, bits, out);
+            }
+        }
+
+        struct codec_header {
+            int order;
+            int bits;
+            size_t count;
+            uint32_t units;
+            intmax_t num;
+            intmax_t den;
+            uint64_t first;
+            uint64_t first_delta;
+            const uint8_t* words;
+        };
+
+        // Reads the header from the 'size' bytes at 'in'. Returns false if the header is malformed or truncated.
+        inline bool read_codec_header(const uint8_t* in, size_t size, codec_header& h) {
+            if (size < 6) {
+                return false;
+            }
+            const uint8_t* end = in + size;
+            h.bits = in[0] & 0x7F;
+            h.order = (in[0] >> 7) + 1;
+            h.count = in[1];
+            h.units = get_le32(in + 2);
+            uint64_t num;
+            uint64_t den;
+            const uint8_t* p = get_varint(in + 6, end, num);
+            p = p ? get_varint(p, end, den) : nullptr;
+            p = p ? get_varint(p, end, h.first) : nullptr;
+            h.first_delta = 0;
+            if (p && h.order == 2) {
+                p = get_varint(p, end, h.first_delta);
+            }
+            h.num = static_cast<intmax_t>(unzigzag(num));
+            h.den = static_cast<intmax_t>(den);
+            h.words = p;
+            return p && h.bits <= 64 && h.count >= 1 && h.count <= codec_block;
+        }
+    }  // namespace detail
+
+    // Encodes and decodes series of quantities Q with an integer value type. Encoding uses the given order, decoding
+    // accepts blocks of either order.
+    template <typename Q, delta_order Order = delta_order::delta>
+    class column_codec {
+        static_assert(is_quantity_v<Q>, "column_codec requires a quantity");
+        static_assert(numeric_limits<typename Q::value_type>::is_integer, "column_codec requires integer counts");
+        static_assert(detail::nibble_units<typename Q::units>(), "Unit exponents must be in [-8, 7]");
+
+        using value_type = typename Q::value_type;
+        using scale = typename Q::scale;
+
+    public:
+        constexpr static size_t block_size = detail::codec_block;
+        // The largest encoded block, size output buffers by this.
+        constexpr static size_t max_block_bytes = detail::codec_max_header + 4 * detail::packed_words(64);
+
+        // The number of bytes needed to encode n samples in the worst case.
+        constexpr static size_t max_bytes(size_t n) { return (n + block_size - 1) / block_size * max_block_bytes; }
+
+        // Encodes n samples, 1 <= n <= block_size, into out. Returns the number of bytes written.
+        static size_t encode_block(const Q* in, size_t n, uint8_t* out) {
+            // Wrapping arithmetic modulo 2^64 round trips exactly whatever the differences are.
+            const auto raw = [&](size_t i) { return static_cast<uint64_t>(static_cast<int64_t>(in[i].count())); };
+            // With deltas of deltas the first delta goes in the header, so that a ramp packs to zero bits.
+            const uint64_t first_delta = Order == delta_order::delta_of_delta && n > 1 ? raw(1) - raw(0) : 0;
+
+            uint64_t residuals[detail::codec_block] = {};
+            uint64_t prev = raw(0);
+            uint64_t prev_delta = first_delta;
+            uint64_t any = 0;
+            for (size_t i = 1; i < n; ++i) {
+                const uint64_t x = raw(i);
+                const uint64_t delta = x - prev;
+                residuals[i] = detail::zigzag(Order == delta_order::delta ? delta : delta - prev_delta);
+                any |= residuals[i];
+                prev = x;
+                prev_delta = delta;
+            }
+            int bits = 0;
+            while (bits < 64 && (any >> bits) != 0) {
+                ++bits;
+            }
+
+            out[0] = static_cast<uint8_t>(bits | (static_cast<int>(Order) - 1) << 7);
+            out[1] = static_cast<uint8_t>(n);
+            detail::put_le32(out + 2, detail::packed_units<typename Q::units>());
+            uint8_t* p = detail::put_varint(out + 6, detail::zigzag(static_cast<uint64_t>(scale::num)));
+            p = detail::put_varint(p, static_cast<uint64_t>(scale::den));
+            p = detail::put_varint(p, detail::zigzag(raw(0)));
+            if (Order == delta_order::delta_of_delta) {
+                p = detail::put_varint(p, detail::zigzag(first_delta));
+            }
+
+            uint32_t part[detail::codec_block];
+            for (size_t i = 0; i < block_size; ++i) {
+                part[i] = static_cast<uint32_t>(residuals[i]);
+            }
+            p = detail::pack_lanes(part, bits < 32 ? bits : 32, p);
+            if (bits > 32) {
+                for (size_t i = 0; i < block_size; ++i) {
+                    part[i] = static_cast<uint32_t>(residuals[i] >> 32);
+                }
+                p = detail::pack_lanes(part, bits - 32, p);
+            }
+            return size_t(p - out);
+        }
+
+        // Encodes n samples as consecutive blocks. If block_offsets isn't null it receives the byte offset of each
+        // of the (n + block_size - 1) / block_size blocks, for random access. Returns the number of bytes written.
+        static size_t encode(const Q* in, size_t n, uint8_t* out, size_t* block_offsets = nullptr) {
+            size_t bytes = 0;
+            for (size_t i = 0; i < n; i += block_size) {
+                if (block_offsets) {
+                    *block_offsets++ = bytes;
+                }
+                bytes += encode_block(in + i, n - i < block_size ? n - i : block_size, out + bytes);
+            }
+            return bytes;
+        }
+
+        // The size in bytes of the block at 'in', read from its header, where 'bytes' bytes are available. Returns 0 if
+        // the header is malformed or the block is longer than 'bytes'.
+        static size_t block_bytes(const uint8_t* in, size_t bytes) {
+            detail::codec_header h;
+            return read_block(in, bytes, h);
+        }
+
+        // Decodes the block at 'in', where 'bytes' bytes are available, into out, which must have room for the
+        // samples of the block, at most block_size. Returns the number of samples, or 0 if the block is malformed,
+        // truncated, or holds other units or another scale than Q.
+        static size_t decode_block(const uint8_t* in, size_t bytes, Q* out) {
+            detail::codec_header h;
+            return read_block(in, bytes, h) != 0 && matches(h) ? unpack_block(h, out) : 0;
+        }
+
+        // Decodes consecutive blocks from 'bytes' bytes at 'in' into out, which has room for 'capacity' samples.
+        // Stops at a malformed, truncated or mismatching block, or at a block with more samples than there is room
+        // left for. Returns the number of samples decoded.
+        static size_t decode(const uint8_t* in, size_t bytes, Q* out, size_t capacity) {
+            size_t n = 0;
+            size_t offset = 0;
+            while (offset < bytes) {
+                detail::codec_header h;
+                const size_t block = read_block(in + offset, bytes - offset, h);
+                if (block == 0 || !matches(h) || h.count > capacity - n) {
+                    break;
+                }
+                n += unpack_block(h, out + n);
+                offset += block;
+            }
+            return n;
+        }
+
+    private:
+        // Reads the header of the block at 'in' and returns the size of the block, or 0 if the header is malformed or
+        // the block is longer than 'bytes'.
+        static size_t read_block(const uint8_t* in, size_t bytes, detail::codec_header& h) {
+            if (!detail::read_codec_header(in, bytes, h)) {
+                return 0;
+            }
+            const size_t block = size_t(h.words - in) + 4 * detail::packed_words(h.bits);
+            return block <= bytes ? block : 0;
+        }
+
+        static bool matches(const detail::codec_header& h) {
+            return h.units == detail::packed_units<typename Q::units>() && h.num == scale::num && h.den == scale::den;
+        }
+
+        static size_t unpack_block(const detail::codec_header& h, Q* out) {
+            uint32_t low[detail::codec_block];
+            uint32_t high[detail::codec_block];
+            const int low_bits = h.bits < 32 ? h.bits : 32;
+            detail::unpack(h.words, low_bits, low);
+            if (h.bits > 32) {
+                detail::unpack(h.words + 4 * detail::packed_words(low_bits), h.bits - 32, high);
+            }
+
+            uint64_t x = detail::unzigzag(h.first);
+            uint64_t delta = detail::unzigzag(h.first_delta);
+            out[0] = Q(static_cast<value_type>(x));
+            for (size_t i = 1; i < h.count; ++i) {
+                const uint64_t r = detail::unzigzag(h.bits > 32 ? uint64_t(high[i]) << 32 | low[i] : low[i]);
+                delta = h.order == 1 ? r : delta + r;
+                x += delta;
+                out[i] = Q(static_cast<value_type>(x));
+            }
+            return h.count;
+        }
+    };
+}  // namespace ctd
+
+#endif
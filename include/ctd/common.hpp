@@ -0,0 +1,13 @@
+/**
+* This file provides the basic types of <cstddef> for systems where STL isn't present.
+*/
+#ifndef CTD_COMMON_HPP
+#define CTD_COMMON_HPP
+
+namespace ctd_impl {
+    using size_t = decltype(sizeof(0));
+    using ptrdiff_t = decltype(static_cast<int*>(nullptr) - static_cast<int*>(nullptr));
+    using nullptr_t = decltype(nullptr);
+}  // namespace ctd_impl
+
+#endif
@@ -0,0 +1,313 @@
+/*
+* This file provides complex valued quantities, e.g. phasors for AC analysis and impedances. Quantities of
+* std::complex<float> or std::complex<double> work with the standard library, and fixed_complex is an integer complex
+* type for targets without floating point. Units and scales propagate through the quantity operators exactly as for
+* scalars. The magnitude and phase of fixed_complex values are computed with integer CORDIC, the phase as a
+* binary_angle.
+*/
+#ifndef CTD_COMPLEX_HPP
+#define CTD_COMPLEX_HPP
+
+#include <cstdint>
+
+#ifdef HAS_STL
+#include <complex>
+#endif
+
+#include "angle.hpp"
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // The component type of products of two T, which holds 2 * T_max^2 for components larger than T_min.
+        template <typename T>
+        struct complex_product {
+            static_assert(sizeof(T) <= 4, "Products of fixed_complex need components of at most 32 bits");
+            using type = conditional_t<sizeof(T) == 1, int16_t, conditional_t<sizeof(T) == 2, int32_t, int64_t>>;
+        };
+
+        template <typename T>
+        using complex_product_t = typename complex_product<T>::type;
+    }  // namespace detail
+
+    // A complex number with signed integer components. Products widen the components like the scalar quantity
+    // operators do, and use three multiplications instead of four. Components must be larger than the most negative
+    // value of T, so that products can't overflow. Products, the magnitude and the phase need components of at most
+    // 32 bits, and division of at most 16 bits, as they are computed in twice the width. Wider components, e.g. the
+    // products themselves, can only be added, subtracted and scaled.
+    template <typename T>
+    class fixed_complex {
+        static_assert(numeric_limits<T>::is_integer && numeric_limits<T>::is_signed,
+            "fixed_complex requires a signed integer type");
+
+    public:
+        using value_type = T;
+
+        constexpr fixed_complex() = default;
+        constexpr fixed_complex(T re, T im = T(0)) : re(re), im(im) {}
+
+        // Converts like the component types do, so that quantities of fixed_complex convert like scalar ones.
+        template <typename U>
+        constexpr fixed_complex(const fixed_complex<U>& other)
+            : re(static_cast<T>(other.real())), im(static_cast<T>(other.imag())) {}
+
+        constexpr T real() const { return re; }
+        constexpr T imag() const { return im; }
+
+        constexpr fixed_complex operator-() const { return fixed_complex(static_cast<T>(-re), static_cast<T>(-im)); }
+
+        constexpr fixed_complex& operator+=(const fixed_complex& rhs) {
+            re = static_cast<T>(re + rhs.re);
+            im = static_cast<T>(im + rhs.im);
+            return *this;
+        }
+
+        constexpr fixed_complex& operator-=(const fixed_complex& rhs) {
+            re = static_cast<T>(re - rhs.re);
+            im = static_cast<T>(im - rhs.im);
+            return *this;
+        }
+
+        friend constexpr bool operator==(const fixed_complex& lhs, const fixed_complex& rhs) {
+            return lhs.re == rhs.re && lhs.im == rhs.im;
+        }
+
+        friend constexpr bool operator!=(const fixed_complex& lhs, const fixed_complex& rhs) { return !(lhs == rhs); }
+
+    private:
+        T re;
+        T im;
+    };
+
+    template <typename T>
+    struct is_fixed_complex : false_type {};
+
+    template <typename T>
+    struct is_fixed_complex<fixed_complex<T>> : true_type {};
+
+    template <typename L, typename R>
+    constexpr auto operator+(const fixed_complex<L>& lhs, const fixed_complex<R>& rhs) {
+        using V = decltype(lhs.real() + rhs.real());
+        return fixed_complex<V>(lhs.real() + rhs.real(), lhs.imag() + rhs.imag());
+    }
+
+    template <typename L, typename R>
+    constexpr auto operator-(const fixed_complex<L>& lhs, const fixed_complex<R>& rhs) {
+        using V = decltype(lhs.real() - rhs.real());
+        return fixed_complex<V>(lhs.real() - rhs.real(), lhs.imag() - rhs.imag());
+    }
+
+    // (a + bi)(c + di) = (k1 - k3) + (k1 + k2)i with k1 = c(a + b), k2 = a(d - c) and k3 = b(c + d).
+    template <typename T>
+    constexpr auto operator*(const fixed_complex<T>& lhs, const fixed_complex<T>& rhs) {
+        using P = detail::complex_product_t<T>;
+        const P a = lhs.real();
+        const P b = lhs.imag();
+        const P c = rhs.real();
+        const P d = rhs.imag();
+        const P k1 = static_cast<P>(c * (a + b));
+        const P k2 = static_cast<P>(a * (d - c));
+        const P k3 = static_cast<P>(b * (c + d));
+        return fixed_complex<P>(static_cast<P>(k1 - k3), static_cast<P>(k1 + k2));
+    }
+
+    template <typename T, typename S>
+        requires numeric_limits<S>::is_integer
+    constexpr auto operator*(const fixed_complex<T>& lhs, S rhs) {
+        using V = decltype(lhs.real() * rhs);
+        return fixed_complex<V>(lhs.real() * rhs, lhs.imag() * rhs);
+    }
+
+    template <typename S, typename T>
+        requires numeric_limits<S>::is_integer
+    constexpr auto operator*(S lhs, const fixed_complex<T>& rhs) {
+        return rhs * lhs;
+    }
+
+    // Truncating division like integer division, the numerator is computed in the product type.
+    template <typename T>
+    constexpr auto operator/(const fixed_complex<T>& lhs, const fixed_complex<T>& rhs) {
+        using P = detail::complex_product_t<T>;
+        using W = detail::complex_product_t<P>;
+        const W a = lhs.real();
+        const W b = lhs.imag();
+        const W c = rhs.real();
+        const W d = rhs.imag();
+        const W den = c * c + d * d;
+        return fixed_complex<P>(static_cast<P>((a * c + b * d) / den), static_cast<P>((b * c - a * d) / den));
+    }
+
+    template <typename T, typename S>
+        requires numeric_limits<S>::is_integer
+    constexpr auto operator/(const fixed_complex<T>& lhs, S rhs) {
+        using V = decltype(lhs.real() / rhs);
+        return fixed_complex<V>(lhs.real() / rhs, lhs.imag() / rhs);
+    }
+
+    template <typename T>
+    constexpr fixed_complex<T> conj(const fixed_complex<T>& z) {
+        return fixed_complex<T>(z.real(), static_cast<T>(-z.imag()));
+    }
+
+    namespace detail {
+        // Series of atan(x), only used to generate the CORDIC table at compile time. Converges for |x| <= 1/2.
+        constexpr double atan_series(double x) {
+            double term = x;
+            double sum = x;
+            for (int n = 1; n < 40; ++n) {
+                term *= -x * x;
+                sum += term / (2 * n + 1);
+            }
+            return sum;
+        }
+
+        // atan(2^-i) as 32 bit binary angles.
+        struct cordic_table {
+            uint32_t angles[32];
+
+            constexpr cordic_table() : angles() {
+                constexpr double turn = 4294967296.0 / (2 * 3.14159265358979323846);
+                angles[0] = uint32_t(1) << 29;  // atan(1) is an eighth of a turn.
+                for (int i = 1; i < 32; ++i) {
+                    double x = 1.0;
+                    for (int k = 0; k < i; ++k) {
+                        x /= 2;
+                    }
+                    angles[i] = static_cast<uint32_t>(atan_series(x) * turn + 0.5);
+                }
+            }
+        };
+
+        inline constexpr cordic_table cordic_table_v{};
+
+        // 1 / prod(sqrt(1 + 2^-2i)), the inverse of the CORDIC gain, as a 0.32 fixed point number.
+        inline constexpr int64_t cordic_inverse_gain = 2608131496;
+
+        template <typename T>
+        struct cordic_traits {
+            static_assert(sizeof(T) <= 4, "CORDIC needs components of at most 32 bits");
+            // Working type and the guard bits the components are shifted up by, leaving room for the CORDIC gain
+            // and the sqrt(2) growth of the magnitude.
+            using work = conditional_t<(sizeof(T) <= 2), int32_t, int64_t>;
+            constexpr static int guard = (sizeof(T) <= 2 ? 29 : 60) - numeric_limits<T>::digits;
+            constexpr static int iterations = sizeof(T) <= 2 ? 16 : 32;
+            using angle = binary_angle<conditional_t<(sizeof(T) <= 2), uint16_t, uint32_t>>;
+        };
+
+        struct cordic_result {
+            int64_t x;
+            uint32_t phase;
+        };
+
+        // CORDIC in vectoring mode: rotates (re, im) onto the positive real axis and sums the rotations.
+        template <typename T>
+        constexpr cordic_result cordic_vector(T re, T im) {
+            using traits = cordic_traits<T>;
+            using W = typename traits::work;
+            W x = static_cast<W>(W(re) * (W(1) << traits::guard));
+            W y = static_cast<W>(W(im) * (W(1) << traits::guard));
+            uint32_t z = 0;
+            if (x == 0 && y == 0) {
+                return { 0, 0 };
+            }
+            // CORDIC converges for angles within about 99.9 degrees, so the left half plane is turned first.
+            if (x < 0) {
+                x = -x;
+                y = -y;
+                z = uint32_t(1) << 31;
+            }
+            for (int i = 0; i < traits::iterations; ++i) {
+                const W dx = y >> i;
+                const W dy = x >> i;
+                if (y > 0) {
+                    x += dx;
+                    y -= dy;
+                    z += cordic_table_v.angles[i];
+                }
+                else {
+                    x -= dx;
+                    y += dy;
+                    z -= cordic_table_v.angles[i];
+                }
+            }
+            return { int64_t(x), z };
+        }
+    }  // namespace detail
+
+    // The magnitude |z|, within one LSB, in the product type which holds sqrt(2) times the largest component.
+    template <typename T>
+    constexpr auto abs(const fixed_complex<T>& z) {
+        using P = detail::complex_product_t<T>;
+        constexpr int guard = detail::cordic_traits<T>::guard;
+        const int64_t x = detail::cordic_vector(z.real(), z.imag()).x;
+        // x is positive with at most 62 bits, the multiply is split so that it doesn't overflow.
+        const int64_t hi = (x >> 32) * detail::cordic_inverse_gain;
+        const int64_t lo = int64_t((uint64_t(x & 0xFFFFFFFF) * uint64_t(detail::cordic_inverse_gain)) >> 32);
+        return static_cast<P>((hi + lo + (int64_t(1) << (guard - 1))) >> guard);
+    }
+
+    // The phase of z as a binary angle of 16 bits for components of up to 16 bits, 32 bits otherwise. The phase of
+    // zero is zero.
+    template <typename T>
+    constexpr auto arg(const fixed_complex<T>& z) {
+        using angle = typename detail::cordic_traits<T>::angle;
+        using raw = typename angle::value_type;
+        constexpr int drop = 32 - angle::bits;
+        const uint32_t phase = detail::cordic_vector(z.real(), z.imag()).phase;
+        if constexpr (drop == 0) {
+            return angle(phase);
+        }
+        else {
+            return angle(static_cast<raw>((phase + (uint32_t(1) << (drop - 1))) >> drop));
+        }
+    }
+
+    //
+    // Complex valued quantities
+    //
+
+    // The real and imaginary parts of a complex quantity, with its units and scale.
+    template <typename V, typename Units, typename Scale>
+        requires detail::complex_like<V>
+    constexpr auto real(const quantity<V, Units, Scale>& q) {
+        return quantity<typename V::value_type, Units, Scale>(q.count().real());
+    }
+
+    template <typename V, typename Units, typename Scale>
+        requires detail::complex_like<V>
+    constexpr auto imag(const quantity<V, Units, Scale>& q) {
+        return quantity<typename V::value_type, Units, Scale>(q.count().imag());
+    }
+
+    template <typename V, typename Units, typename Scale>
+        requires detail::complex_like<V>
+    constexpr auto conj(const quantity<V, Units, Scale>& q) {
+        return quantity<V, Units, Scale>(conj(q.count()));
+    }
+
+    // The magnitude of a complex quantity, with its units and scale.
+    template <typename V, typename Units, typename Scale>
+        requires detail::complex_like<V>
+    constexpr auto abs(const quantity<V, Units, Scale>& q) {
+        const auto m = abs(q.count());
+        return quantity<decltype(m), Units, Scale>(m);
+    }
+
+    // The phase of a complex quantity, a binary_angle for fixed_complex and an angle in radians for std::complex.
+    template <typename V, typename Units, typename Scale>
+    constexpr auto arg(const quantity<fixed_complex<V>, Units, Scale>& q) {
+        return arg(q.count());
+    }
+
+#ifdef HAS_STL
+    template <typename V, typename Units, typename Scale>
+    auto arg(const quantity<std::complex<V>, Units, Scale>& q) {
+        return angle<V>(std::arg(q.count()));
+    }
+#endif
+}  // namespace ctd
+
+#endif
@@ -0,0 +1,16 @@
+/*
+* This file provides the check that fails a constant evaluation, for arguments that can only be validated while they
+* are evaluated, such as constructor arguments, rather than with a static_assert on template arguments.
+*/
+#ifndef CTD_CONSTANT_EVALUATION_HPP
+#define CTD_CONSTANT_EVALUATION_HPP
+
+namespace ctd {
+    namespace detail {
+        // Intentionally not constexpr, calling it in a constant evaluation makes the evaluation fail and the compiler
+        // reports the call, i.e. the failed check. It does nothing at run time.
+        inline void fail_constant_evaluation() {}
+    }  // namespace detail
+}  // namespace ctd
+
+#endif
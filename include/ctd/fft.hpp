@@ -0,0 +1,255 @@
+/*
+* This file provides an in-place FFT of arrays of complex quantities, with Q15 (fixed_complex<int16_t>), Q31
+* (fixed_complex<int32_t>) or floating point (std::complex<float>) counts, and power spectra of the result.
+*
+* The transform is normalized by 1/N: bin k of the result is the complex amplitude X[k] / N of the samples, in the units
+* and scale of the samples. In fixed point this is the usual halving of every radix-2 stage, which keeps the values in
+* range without a data dependent block exponent, so the scaling is part of the result rather than something the caller
+* has to track. The passes are radix-4 with a single radix-2 pass when N is not a power of 4, and the twiddle factors
+* are read from the compile time quarter wave table that sin() and cos() of binary angles use.
+*/
+#ifndef CTD_FFT_HPP
+#define CTD_FFT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "angle.hpp"
+#include "complex.hpp"
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        constexpr int fft_log2(size_t n) {
+            int ans = 0;
+            while (n > 1) {
+                n >>= 1;
+                ++ans;
+            }
+            return ans;
+        }
+
+        // Arithmetic of one FFT over components of type T. Fixed point products are computed in 'wide' and rounded
+        // back to the fraction bits of the twiddle table, floating point ones are used as they are.
+        template <typename T, size_t N>
+        struct fft_arithmetic {
+            constexpr static bool is_integer = numeric_limits<T>::is_integer;
+            using wide = conditional_t<!is_integer, T, conditional_t<(sizeof(T) <= 2), int32_t, int64_t>>;
+            using table_type = conditional_t<is_integer && sizeof(T) <= 2, int16_t, int32_t>;
+            constexpr static int frac = numeric_limits<table_type>::digits;
+            constexpr static size_t quarter = N / 4;
+            constexpr static auto& table = sine_table_v<table_type, fft_log2(N) - 2>.values;
+
+            // sin(2 * pi * n / N) for n in [0, N), scaled like the table for integer T.
+            constexpr static wide sin(size_t n) {
+                const size_t q = n / quarter;
+                const size_t r = n % quarter;
+                const wide s = from_table(table[(q & 1) ? quarter - r : r]);
+                return (q & 2) ? -s : s;
+            }
+
+            constexpr static wide cos(size_t n) { return sin((n + quarter) % N); }
+
+            constexpr static wide from_table(table_type v) {
+                if constexpr (is_integer) {
+                    return v;
+                }
+                else {
+                    constexpr wide unit = wide(1) / wide(numeric_limits<table_type>::max());
+                    return wide(v) * unit;
+                }
+            }
+
+            // The real and imaginary parts of (wr + i wi) * (xr + i xi). For Q31 each sum of two products is below
+            // 2^63 because no factor is the most negative value of its type.
+            constexpr static void multiply(wide wr, wide wi, wide xr, wide xi, wide& re, wide& im) {
+                if constexpr (is_integer) {
+                    constexpr wide round = wide(1) << (frac - 1);
+                    re = (wr * xr - wi * xi + round) >> frac;
+                    im = (wr * xi + wi * xr + round) >> frac;
+                }
+                else {
+                    re = wr * xr - wi * xi;
+                    im = wr * xi + wi * xr;
+                }
+            }
+
+            constexpr static T half(wide v) {
+                if constexpr (is_integer) {
+                    return static_cast<T>((v + 1) >> 1);
+                }
+                else {
+                    return v * T(0.5);
+                }
+            }
+
+            constexpr static T quarter_of(wide v) {
+                if constexpr (is_integer) {
+                    return static_cast<T>((v + 2) >> 2);
+                }
+                else {
+                    return v * T(0.25);
+                }
+            }
+        };
+
+        // Permutes the N values at 'data' to bit reversed order.
+        template <size_t N, typename Q>
+        constexpr void bit_reverse(Q* data) {
+            size_t j = 0;
+            for (size_t i = 1; i < N; ++i) {
+                size_t bit = N >> 1;
+                while (j & bit) {
+                    j ^= bit;
+                    bit >>= 1;
+                }
+                j ^= bit;
+                if (i < j) {
+                    const Q t = data[i];
+                    data[i] = data[j];
+                    data[j] = t;
+                }
+            }
+        }
+    }  // namespace detail
+
+    // Transforms the N complex quantities at 'data' in place to X[k] / N, the complex amplitude of frequency k / N of
+    // the sample rate, in bin k. N must be a power of 2 and at least 4. Fixed point counts must have a magnitude of
+    // at most the largest value of their components, which real valued samples always have, and the results do too.
+    template <size_t N, typename C, typename Units, typename Scale>
+        requires detail::complex_like<C>
+    constexpr void fft(quantity<C, Units, Scale>* data) {
+        static_assert(N >= 4 && (N & (N - 1)) == 0, "The FFT size must be a power of 2 and at least 4");
+        using T = typename C::value_type;
+        using math = detail::fft_arithmetic<T, N>;
+        using wide = typename math::wide;
+        using Q = quantity<C, Units, Scale>;
+
+        detail::bit_reverse<N>(data);
+
+        size_t h = 1;
+        if (detail::fft_log2(N) % 2 == 1) {
+            // The twiddle factors of the first radix-2 stage are all 1.
+            for (size_t j = 0; j < N; j += 2) {
+                const C a = data[j].count();
+                const C b = data[j + 1].count();
+                data[j] = Q(C(math::half(wide(a.real()) + b.real()), math::half(wide(a.imag()) + b.imag())));
+                data[j + 1] = Q(C(math::half(wide(a.real()) - b.real()), math::half(wide(a.imag()) - b.imag())));
+            }
+            h = 2;
+        }
+
+        // Each pass does the radix-2 stages of spans h and 2h as one radix-4 butterfly with three twiddle factors,
+        // W^2k, W^k and W^3k of the 4h point transform.
+        for (; h < N; h *= 4) {
+            const size_t stride = N / (4 * h);
+            for (size_t k = 0; k < h; ++k) {
+                const size_t n2 = k * stride;
+                const size_t n1 = 2 * n2;
+                const size_t n3 = n1 + n2;
+                // exp(-i x) = cos(x) - i sin(x)
+                const wide w1r = math::cos(n1);
+                const wide w1i = -math::sin(n1);
+                const wide w2r = math::cos(n2);
+                const wide w2i = -math::sin(n2);
+                const wide w3r = math::cos(n3);
+                const wide w3i = -math::sin(n3);
+                for (size_t j = k; j < N; j += 4 * h) {
+                    const C x0 = data[j].count();
+                    const C x1 = data[j + h].count();
+                    const C x2 = data[j + 2 * h].count();
+                    const C x3 = data[j + 3 * h].count();
+                    wide t1r, t1i, t2r, t2i, t3r, t3i;
+                    math::multiply(w1r, w1i, x1.real(), x1.imag(), t1r, t1i);
+                    math::multiply(w2r, w2i, x2.real(), x2.imag(), t2r, t2i);
+                    math::multiply(w3r, w3i, x3.real(), x3.imag(), t3r, t3i);
+                    const wide a0r = wide(x0.real()) + t1r;
+                    const wide a0i = wide(x0.imag()) + t1i;
+                    const wide a1r = wide(x0.real()) - t1r;
+                    const wide a1i = wide(x0.imag()) - t1i;
+                    const wide b0r = t2r + t3r;
+                    const wide b0i = t2i + t3i;
+                    const wide b1r = t2r - t3r;
+                    const wide b1i = t2i - t3i;
+                    data[j] = Q(C(math::quarter_of(a0r + b0r), math::quarter_of(a0i + b0i)));
+                    data[j + 2 * h] = Q(C(math::quarter_of(a0r - b0r), math::quarter_of(a0i - b0i)));
+                    // a1 - i b1 and a1 + i b1
+                    data[j + h] = Q(C(math::quarter_of(a1r + b1i), math::quarter_of(a1i - b1r)));
+                    data[j + 3 * h] = Q(C(math::quarter_of(a1r - b1i), math::quarter_of(a1i + b1r)));
+                }
+            }
+        }
+    }
+
+    namespace detail {
+        // |z|^2 is computed in int64_t for fixed point counts, shifted right by 2 for Q31 so that twice it still fits.
+        // The shift goes into the scale of the result.
+        template <typename C>
+        struct power_traits {
+            using component = typename C::value_type;
+            constexpr static bool is_integer = numeric_limits<component>::is_integer;
+            using value_type = conditional_t<is_integer, int64_t, component>;
+            constexpr static int shift = is_integer && sizeof(component) > 2 ? 2 : 0;
+
+            constexpr static value_type norm(const C& z) {
+                const value_type re = z.real();
+                const value_type im = z.imag();
+                if constexpr (is_integer) {
+                    return (re * re + im * im) >> shift;
+                }
+                else {
+                    return re * re + im * im;
+                }
+            }
+        };
+
+        template <typename Units>
+        using squared_units = units::detail::unit_powers_add<Units, Units>;
+
+        // Writes the one sided spectrum of a real signal from its normalized FFT: the power of bin k and of bin N - k
+        // is added into bin k for 0 < k < N / 2, so the result has N / 2 + 1 bins.
+        template <size_t N, typename C, typename Units, typename Scale, typename Out>
+        constexpr void one_sided(const quantity<C, Units, Scale>* spectrum, Out* out) {
+            using traits = power_traits<C>;
+            for (size_t k = 0; k <= N / 2; ++k) {
+                const auto p = traits::norm(spectrum[k].count());
+                out[k] = Out(k == 0 || k == N / 2 ? p : 2 * p);
+            }
+        }
+    }  // namespace detail
+
+    // The power of each of the N / 2 + 1 bins of the one sided spectrum of a real signal, in the squared units of Q.
+    template <typename Q>
+    using power_spectrum_t = quantity<typename detail::power_traits<typename Q::value_type>::value_type,
+        detail::squared_units<typename Q::units>,
+        ratio_multiply<ratio_multiply<typename Q::scale, typename Q::scale>,
+            ratio<intmax_t(1) << detail::power_traits<typename Q::value_type>::shift>>>;
+
+    // The power spectral density of N samples taken at SampleRate, a ratio in hertz, in squared units of Q per hertz.
+    // The bin width SampleRate / N is part of the scale, so the counts are those of power_spectrum_t.
+    template <typename Q, size_t N, typename SampleRate>
+    using power_spectral_density_t = quantity<typename power_spectrum_t<Q>::value_type,
+        units::detail::unit_powers_subtract<typename power_spectrum_t<Q>::units, units::hertz>,
+        ratio_divide<ratio_multiply<typename power_spectrum_t<Q>::scale, ratio<N>>, SampleRate>>;
+
+    // Writes the N / 2 + 1 bin powers of the one sided spectrum of a real signal from the result of fft<N>. Their sum
+    // is the mean square of the signal.
+    template <size_t N, typename C, typename Units, typename Scale>
+    constexpr void power_spectrum(const quantity<C, Units, Scale>* spectrum,
+        power_spectrum_t<quantity<C, Units, Scale>>* out) {
+        detail::one_sided<N>(spectrum, out);
+    }
+
+    // Writes the N / 2 + 1 bins of the one sided power spectral density of a real signal sampled at SampleRate from
+    // the result of fft<N>, a periodogram with a rectangular window.
+    template <size_t N, typename SampleRate, typename C, typename Units, typename Scale>
+    constexpr void power_spectral_density(const quantity<C, Units, Scale>* spectrum,
+        power_spectral_density_t<quantity<C, Units, Scale>, N, SampleRate>* out) {
+        detail::one_sided<N>(spectrum, out);
+    }
+}  // namespace ctd
+
+#endif
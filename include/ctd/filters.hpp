@@ -0,0 +1,349 @@
+/*
+* This file provides streaming filters for quantity readings: moving average, exponential smoothing, running mean and
+* variance, and a sliding window median. All of them have a fixed capacity and allocate no memory. Integer filters
+* accumulate in a type that is wide enough for the worst case input, so they can't overflow.
+*/
+#ifndef CTD_FILTERS_HPP
+#define CTD_FILTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bounded.hpp"
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // An integer type that can hold Factor times any value of V, or V itself for floating point types.
+        template <typename V, intmax_t Factor, bool = numeric_limits<V>::is_integer>
+        struct widened {
+            using type = V;
+        };
+
+        template <typename V, intmax_t Factor>
+        struct widened<V, Factor, true> {
+            static_assert(numeric_limits<V>::digits < 64 && intmax_t(numeric_limits<V>::max()) <= INTMAX_MAX / Factor,
+                "The filter could overflow, use a narrower value type or a smaller filter");
+            using type = least_int_t<intmax_t(numeric_limits<V>::min()) * Factor,
+                intmax_t(numeric_limits<V>::max()) * Factor>;
+        };
+
+        template <typename V, intmax_t Factor>
+        using widened_t = typename widened<V, Factor>::type;
+
+        // Division rounded to the nearest integer, ties away from zero. Exact division for floating point types.
+        template <typename T, typename D>
+        constexpr T divide_nearest(T n, D d) {
+            if constexpr (numeric_limits<T>::is_integer) {
+                return static_cast<T>(n < 0 ? (n - T(d / 2)) / T(d) : (n + T(d / 2)) / T(d));
+            }
+            else {
+                return n / T(d);
+            }
+        }
+
+        constexpr int log2_exact(intmax_t v) {
+            int n = 0;
+            while (v > 1) {
+                if (v & 1) {
+                    return -1;
+                }
+                v >>= 1;
+                ++n;
+            }
+            return n;
+        }
+    }  // namespace detail
+
+    // The mean of the last N readings, updated in O(1) by adding the newest and subtracting the oldest reading.
+    template <typename Quantity, size_t N>
+    class moving_average {
+        static_assert(N > 0, "The window must not be empty");
+
+    public:
+        using value_type = typename Quantity::value_type;
+        using sum_type = quantity<detail::widened_t<value_type, N>, typename Quantity::units, typename Quantity::scale>;
+
+        // Adds a reading and returns the new average.
+        constexpr Quantity push(Quantity q) {
+            const value_type v = q.count();
+            total = static_cast<acc_type>(total - window[next] + v);
+            window[next] = v;
+            next = next + 1 == N ? 0 : next + 1;
+            n += n < N;
+            return average();
+        }
+
+        // The average of the readings so far, rounded to nearest for integers. Must not be called while empty.
+        constexpr Quantity average() const {
+            // Once the window is full the division is by a constant, which for power of two sizes is a shift.
+            const acc_type avg = n == N ? detail::divide_nearest(total, N) : detail::divide_nearest(total, n);
+            return static_cast<value_type>(avg);
+        }
+
+        constexpr sum_type sum() const { return total; }
+
+        constexpr size_t size() const { return n; }
+
+        constexpr bool full() const { return n == N; }
+
+        constexpr static size_t capacity() { return N; }
+
+    private:
+        using acc_type = typename sum_type::value_type;
+
+        value_type window[N]{};
+        acc_type total = 0;
+        size_t next = 0;
+        size_t n = 0;
+    };
+
+    // First order low pass y += alpha * (x - y). Alpha is a ratio in (0, 1]. Integer filters keep den times the
+    // output internally so that steps smaller than one LSB accumulate instead of being truncated away, and when the
+    // denominator is a power of two the division is a shift.
+    template <typename Quantity, typename Alpha>
+    class exponential_smoothing {
+        static_assert(Alpha::num > 0 && Alpha::num <= Alpha::den, "Alpha must be in (0, 1]");
+
+    public:
+        using value_type = typename Quantity::value_type;
+        using alpha = typename Alpha::type;
+
+        constexpr exponential_smoothing() = default;
+
+        // Starts at 'initial' rather than at zero, so the output doesn't have to ramp up from zero first.
+        constexpr explicit exponential_smoothing(Quantity initial) { reset(initial); }
+
+        constexpr void reset(Quantity q) {
+            state = static_cast<acc_type>(acc_type(q.count()) * den);
+            started = true;
+        }
+
+        // Adds a reading and returns the new output. The first reading initializes the filter.
+        constexpr Quantity push(Quantity q) {
+            if (!started) {
+                reset(q);
+            }
+            else if constexpr (numeric_limits<value_type>::is_integer) {
+                // Rounded like value(), so that the state settles where the output equals a constant input.
+                state = static_cast<acc_type>(state + acc_type(q.count()) * num - scale_down(state * num + den / 2));
+            }
+            else {
+                state += (q.count() - state) * (value_type(alpha::num) / value_type(alpha::den));
+            }
+            return value();
+        }
+
+        constexpr Quantity value() const {
+            if constexpr (numeric_limits<value_type>::is_integer) {
+                return static_cast<value_type>(scale_down(state + den / 2));
+            }
+            else {
+                return state;
+            }
+        }
+
+    private:
+        constexpr static intmax_t num = alpha::num;
+        constexpr static intmax_t den = numeric_limits<value_type>::is_integer ? alpha::den : 1;
+        constexpr static int shift = detail::log2_exact(den);
+
+        // Wide enough for num * state and state + num * reading, where state is at most den times the largest reading.
+        using acc_type = detail::widened_t<value_type, den * (num + 1)>;
+
+        // Floor division by den, which rounds to nearest after adding den / 2. Right shifts of negative values are
+        // arithmetic since C++20.
+        constexpr static acc_type scale_down(acc_type v) {
+            if constexpr (shift >= 0) {
+                return static_cast<acc_type>(v >> shift);
+            }
+            else {
+                return static_cast<acc_type>(v / den - (v % den < 0));
+            }
+        }
+
+        acc_type state = 0;
+        bool started = false;
+    };
+
+    // Mean and variance of all readings so far, using Welford's algorithm which doesn't suffer from the cancellation
+    // of the naive sum of squares. The variance is in the squared units, e.g. V^2 for voltages, and its square root
+    // is the standard deviation in the original units. Float is the type of the internal state.
+    template <typename Quantity,
+        typename Float = conditional_t<numeric_limits<typename Quantity::value_type>::is_integer, float,
+            typename Quantity::value_type>>
+    class running_variance {
+    public:
+        using units = typename Quantity::units;
+        using scale = typename Quantity::scale;
+        using mean_type = quantity<Float, units, scale>;
+        using variance_type =
+            quantity<Float, ctd::units::detail::unit_powers_add<units, units>, ratio_multiply<scale, scale>>;
+
+        constexpr void push(Quantity q) {
+            ++n;
+            const Float x = static_cast<Float>(q.count());
+            const Float delta = x - m;
+            m += delta / static_cast<Float>(n);
+            m2 += delta * (x - m);
+        }
+
+        constexpr size_t count() const { return n; }
+
+        constexpr mean_type mean() const { return m; }
+
+        // The population variance. Must not be called while empty.
+        constexpr variance_type variance() const { return m2 / static_cast<Float>(n); }
+
+        // The unbiased sample variance. Requires at least two readings.
+        constexpr variance_type sample_variance() const { return m2 / static_cast<Float>(n - 1); }
+
+        auto standard_deviation() const { return sqrt(variance()); }
+
+        constexpr void reset() { *this = running_variance(); }
+
+    private:
+        size_t n = 0;
+        Float m = 0;
+        Float m2 = 0;
+    };
+
+    // The median of the last N readings. The window is kept in two heaps that share one array with the median in
+    // the middle: a max-heap of the smaller readings at negative indices and a min-heap of the larger at positive
+    // indices. A new reading replaces the oldest one in its heap slot and is sifted into place, so an update costs
+    // O(log N) comparisons. For even counts the upper of the two middle readings is returned, like median() in
+    // algorithm.hpp.
+    template <typename Quantity, size_t N>
+    class running_median {
+        static_assert(N > 0, "The window must not be empty");
+
+    public:
+        using index_type = conditional_t<(N <= 127), int8_t, conditional_t<(N <= 32767), int16_t, int32_t>>;
+
+        constexpr running_median() {
+            // Readings are placed alternately on the max-heap and min-heap side while the window fills up.
+            for (size_t i = 0; i < N; ++i) {
+                const auto p = static_cast<index_type>((i + 1) / 2 * (i & 1 ? -1 : 1));
+                pos[i] = p;
+                heap(p) = static_cast<index_type>(i);
+            }
+        }
+
+        // Adds a reading and returns the new median.
+        constexpr Quantity push(Quantity q) {
+            const bool is_new = n < index_type(N);
+            const index_type p = pos[next];
+            const Quantity old = data[next];
+            data[next] = q;
+            next = static_cast<index_type>(next + 1 == index_type(N) ? 0 : next + 1);
+            n = static_cast<index_type>(n + is_new);
+
+            if (p > 0) {
+                if (!is_new && old < q) {
+                    min_sort_down(p * 2);
+                }
+                else if (min_sort_up(p)) {
+                    max_sort_down(-1);
+                }
+            }
+            else if (p < 0) {
+                if (!is_new && q < old) {
+                    max_sort_down(p * 2);
+                }
+                else if (max_sort_up(p)) {
+                    min_sort_down(1);
+                }
+            }
+            else {
+                if (max_count() > 0) {
+                    max_sort_down(-1);
+                }
+                if (min_count() > 0) {
+                    min_sort_down(1);
+                }
+            }
+            return median();
+        }
+
+        // Must not be called while empty.
+        constexpr Quantity median() const { return data[heap(0)]; }
+
+        constexpr size_t size() const { return n; }
+
+        constexpr bool full() const { return n == index_type(N); }
+
+        constexpr static size_t capacity() { return N; }
+
+    private:
+        constexpr static index_type offset = index_type(N / 2);
+
+        constexpr index_type& heap(int i) { return heap_storage[i + offset]; }
+        constexpr index_type heap(int i) const { return heap_storage[i + offset]; }
+
+        constexpr int max_count() const { return n / 2; }
+        constexpr int min_count() const { return (n - 1) / 2; }
+
+        constexpr bool less(int i, int j) const { return data[heap(i)] < data[heap(j)]; }
+
+        // Swaps the readings at i and j if the one at i is smaller.
+        constexpr bool exchange_if_less(int i, int j) {
+            if (!less(i, j)) {
+                return false;
+            }
+            const index_type t = heap(i);
+            heap(i) = heap(j);
+            heap(j) = t;
+            pos[heap(i)] = static_cast<index_type>(i);
+            pos[heap(j)] = static_cast<index_type>(j);
+            return true;
+        }
+
+        constexpr void min_sort_down(int i) {
+            for (; i <= min_count(); i *= 2) {
+                if (i > 1 && i < min_count() && less(i + 1, i)) {
+                    ++i;
+                }
+                if (!exchange_if_less(i, i / 2)) {
+                    break;
+                }
+            }
+        }
+
+        constexpr void max_sort_down(int i) {
+            for (; i >= -max_count(); i *= 2) {
+                if (i < -1 && i > -max_count() && less(i, i - 1)) {
+                    --i;
+                }
+                if (!exchange_if_less(i / 2, i)) {
+                    break;
+                }
+            }
+        }
+
+        // Both return true if the reading moved all the way to the median.
+        constexpr bool min_sort_up(int i) {
+            while (i > 0 && exchange_if_less(i, i / 2)) {
+                i /= 2;
+            }
+            return i == 0;
+        }
+
+        constexpr bool max_sort_up(int i) {
+            while (i < 0 && exchange_if_less(i / 2, i)) {
+                i /= 2;
+            }
+            return i == 0;
+        }
+
+        Quantity data[N]{};
+        index_type pos[N]{};
+        index_type heap_storage[N]{};
+        index_type next = 0;
+        index_type n = 0;
+    };
+}  // namespace ctd
+
+#endif
@@ -0,0 +1,150 @@
+/*
+* This file provides opt-in instrumentation of ratio_convert, which every rescale of a quantity goes through. It is
+* enabled by defining CTD_INSTRUMENT for the whole project, as it changes ratio_convert everywhere. Without it nothing
+* is recorded and conversions compile exactly as before. Each combination of source scale, destination scale and value
+* type gets a record of counters when it is first converted at run time, conversions in constant evaluation aren't
+* counted. The counters aren't synchronized, so they are only exact if conversions happen on one thread.
+*/
+#ifndef CTD_INSTRUMENT_HPP
+#define CTD_INSTRUMENT_HPP
+
+#include <cstdint>
+
+#include "limits.hpp"
+
+#ifdef HAS_STL
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+#endif
+
+namespace ctd {
+    namespace instrument {
+        // The counters of one combination of scales and value type.
+        struct conversion_counters {
+            intmax_t from_num;
+            intmax_t from_den;
+            intmax_t to_num;
+            intmax_t to_den;
+            // The value type, e.g. 15 digits and signed for int16_t.
+            int digits;
+            bool is_signed;
+            bool is_integer;
+
+            // All run time conversions.
+            uint32_t conversions = 0;
+            // Conversions that divide, i.e. where the combined scale isn't a whole number.
+            uint32_t divides = 0;
+            // Conversions with a rounding error, and the magnitude of the errors in units of the result.
+            uint32_t inexact = 0;
+            float max_error = 0;
+            float total_error = 0;
+            // Conversions where the result or the intermediate product uses the top bit of its type.
+            uint32_t near_overflow = 0;
+            // Conversions where the result or the intermediate product doesn't fit its type.
+            uint32_t overflow = 0;
+
+            conversion_counters* next = nullptr;
+            bool registered = false;
+        };
+
+        namespace detail {
+            inline conversion_counters* head = nullptr;
+
+            template <typename From, typename To, typename T>
+            inline conversion_counters counters{ From::num, From::den, To::num, To::den, numeric_limits<T>::digits,
+                numeric_limits<T>::is_signed, numeric_limits<T>::is_integer };
+
+            constexpr double magnitude(double v) { return v < 0 ? -v : v; }
+
+            // Records the conversion of x to y = x * Scale, where Scale = From / To. Wide is the type ratio_scale
+            // computes y in, before it is narrowed to T.
+            template <typename From, typename To, typename T, typename Scale, typename Wide>
+            void record(T x, Wide y) {
+                conversion_counters& c = counters<From, To, T>;
+                if (!c.registered) {
+                    c.registered = true;
+                    c.next = head;
+                    head = &c;
+                }
+                ++c.conversions;
+                c.divides += Scale::den != 1;
+                if constexpr (numeric_limits<T>::is_integer) {
+                    const double exact = double(x) * double(Scale::num) / double(Scale::den);
+                    const auto error = static_cast<float>(magnitude(exact - double(y)));
+                    if (error > 0) {
+                        ++c.inexact;
+                        c.max_error = error > c.max_error ? error : c.max_error;
+                        c.total_error += error;
+                    }
+                    // The product x * num is computed in the type of Wide.
+                    const double product = magnitude(double(x) * double(Scale::num));
+                    const double product_max = double(numeric_limits<Wide>::max());
+                    const bool fits = y <= Wide(numeric_limits<T>::max()) && !(y < Wide(numeric_limits<T>::lowest()));
+                    c.overflow += !fits || product > product_max;
+                    c.near_overflow += magnitude(double(y)) > double(numeric_limits<T>::max()) / 2 ||
+                        product > product_max / 2;
+                }
+            }
+        }  // namespace detail
+
+        // Calls f with the counters of every combination converted so far, most recently added first.
+        template <typename F>
+        void for_each(F&& f) {
+            for (const conversion_counters* c = detail::head; c != nullptr; c = c->next) {
+                f(*c);
+            }
+        }
+
+        // Zeroes all counters, e.g. at the start of a control cycle.
+        inline void reset() {
+            for (conversion_counters* c = detail::head; c != nullptr; c = c->next) {
+                c->conversions = 0;
+                c->divides = 0;
+                c->inexact = 0;
+                c->max_error = 0;
+                c->total_error = 0;
+                c->near_overflow = 0;
+                c->overflow = 0;
+            }
+        }
+
+#ifdef HAS_STL
+        // Prints a table of all combinations, the most frequently converted first.
+        inline void print(std::ostream& os) {
+            std::vector<const conversion_counters*> rows;
+            for_each([&](const conversion_counters& c) { rows.push_back(&c); });
+            std::stable_sort(rows.begin(), rows.end(), [](const conversion_counters* a, const conversion_counters* b) {
+                return a->conversions > b->conversions;
+            });
+
+            const auto type_name = [](const conversion_counters& c) {
+                if (c.is_integer) {
+                    return std::string(c.is_signed ? "int" : "uint") + std::to_string(c.digits + c.is_signed);
+                }
+                return std::string(c.digits <= 24 ? "float" : c.digits <= 53 ? "double" : "long double");
+            };
+            const auto scale_name = [](intmax_t num, intmax_t den) {
+                return den == 1 ? std::to_string(num) : std::to_string(num) + "/" + std::to_string(den);
+            };
+
+            os << std::left << std::setw(24) << "from" << std::setw(24) << "to" << std::setw(8) << "type" << std::right
+               << std::setw(12) << "conversions" << std::setw(12) << "divides" << std::setw(12) << "inexact"
+               << std::setw(12) << "max error" << std::setw(12) << "mean error" << std::setw(14) << "near overflow"
+               << std::setw(10) << "overflow" << '\n';
+            for (const conversion_counters* c : rows) {
+                const float mean = c->inexact > 0 ? c->total_error / float(c->conversions) : 0.0f;
+                os << std::left << std::setw(24) << scale_name(c->from_num, c->from_den) << std::setw(24)
+                   << scale_name(c->to_num, c->to_den) << std::setw(8) << type_name(*c) << std::right << std::setw(12)
+                   << c->conversions << std::setw(12) << c->divides << std::setw(12) << c->inexact << std::setw(12)
+                   << c->max_error << std::setw(12) << mean << std::setw(14) << c->near_overflow << std::setw(10)
+                   << c->overflow << '\n';
+            }
+        }
+#endif
+    }  // namespace instrument
+}  // namespace ctd
+
+#endif
@@ -0,0 +1,420 @@
+/*
+* This file provides 3-vectors and 3x3 matrices of quantities. Components are stored as raw counts with the units and
+* scale as part of the type, so products such as dot, cross and matrix multiplication propagate the units exactly
+* like the scalar quantity operators, and nothing is rescaled until a result is converted. Rotating batches of int16_t
+* or float vectors uses SSE2 or NEON where available.
+*/
+#ifndef CTD_LINALG_HPP
+#define CTD_LINALG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(HAS_STL) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CTD_LINALG_SSE2
+#elif defined(HAS_STL) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CTD_LINALG_NEON
+#endif
+
+#include "bounded.hpp"
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        template <typename T>
+        constexpr intmax_t max_magnitude() {
+            return intmax_t(numeric_limits<T>::max()) > -intmax_t(numeric_limits<T>::min()) ?
+                intmax_t(numeric_limits<T>::max()) : -intmax_t(numeric_limits<T>::min());
+        }
+
+        // A type that holds the sum of Terms products of A and B without overflow.
+        template <typename A, typename B, intmax_t Terms,
+            bool = numeric_limits<A>::is_integer && numeric_limits<B>::is_integer>
+        struct sum_of_products {
+            using type = decltype(A() * B());
+        };
+
+        template <typename A, typename B, intmax_t Terms>
+        struct sum_of_products<A, B, Terms, true> {
+            static_assert(numeric_limits<A>::digits + numeric_limits<B>::digits <= 60,
+                "The products could overflow, use narrower value types");
+            constexpr static intmax_t bound = Terms * max_magnitude<A>() * max_magnitude<B>();
+            using type = least_int_t<-bound, bound>;
+        };
+
+        template <typename A, typename B, intmax_t Terms>
+        using sum_of_products_t = typename sum_of_products<A, B, Terms>::type;
+
+        template <typename QA, typename QB, intmax_t Terms>
+        using product_quantity = quantity<
+            sum_of_products_t<typename QA::value_type, typename QB::value_type, Terms>,
+            ctd::units::detail::unit_powers_add<typename QA::units, typename QB::units>,
+            ratio_multiply<typename QA::scale, typename QB::scale>>;
+
+        template <typename T>
+        constexpr T saturate(intmax_t v) {
+            return v < intmax_t(numeric_limits<T>::min()) ? numeric_limits<T>::min() :
+                v > intmax_t(numeric_limits<T>::max()) ? numeric_limits<T>::max() : static_cast<T>(v);
+        }
+    }  // namespace detail
+
+    template <typename Quantity>
+    class vec3 {
+    public:
+        using quantity_type = Quantity;
+        using value_type = typename Quantity::value_type;
+        using units = typename Quantity::units;
+        using scale = typename Quantity::scale;
+
+        constexpr vec3() = default;
+
+        constexpr vec3(Quantity x, Quantity y, Quantity z) : c{ x.count(), y.count(), z.count() } {}
+
+        // Converts from another scale of the same units.
+        template <typename OtherQuantity>
+            requires is_same_v<typename OtherQuantity::units, units>
+        constexpr vec3(const vec3<OtherQuantity>& v) : c{ Quantity(v.x()).count(), Quantity(v.y()).count(),
+            Quantity(v.z()).count() } {}
+
+        constexpr Quantity x() const { return c[0]; }
+        constexpr Quantity y() const { return c[1]; }
+        constexpr Quantity z() const { return c[2]; }
+        constexpr Quantity operator[](size_t i) const { return c[i]; }
+
+        // The raw counts, in the order x, y, z.
+        constexpr const value_type* data() const { return c; }
+        constexpr value_type* data() { return c; }
+
+        constexpr vec3 operator-() const {
+            return vec3(static_cast<value_type>(-c[0]), static_cast<value_type>(-c[1]),
+                static_cast<value_type>(-c[2]));
+        }
+
+        constexpr vec3& operator+=(const vec3& rhs) {
+            for (size_t i = 0; i < 3; ++i) {
+                c[i] = static_cast<value_type>(c[i] + rhs.c[i]);
+            }
+            return *this;
+        }
+
+        constexpr vec3& operator-=(const vec3& rhs) {
+            for (size_t i = 0; i < 3; ++i) {
+                c[i] = static_cast<value_type>(c[i] - rhs.c[i]);
+            }
+            return *this;
+        }
+
+        friend constexpr vec3 operator+(vec3 lhs, const vec3& rhs) { return lhs += rhs; }
+        friend constexpr vec3 operator-(vec3 lhs, const vec3& rhs) { return lhs -= rhs; }
+
+        template <typename S>
+            requires numeric_limits<S>::is_specialized
+        friend constexpr vec3 operator*(const vec3& lhs, S rhs) {
+            return vec3(static_cast<value_type>(lhs.c[0] * rhs), static_cast<value_type>(lhs.c[1] * rhs),
+                static_cast<value_type>(lhs.c[2] * rhs));
+        }
+
+        template <typename S>
+            requires numeric_limits<S>::is_specialized
+        friend constexpr vec3 operator*(S lhs, const vec3& rhs) {
+            return rhs * lhs;
+        }
+
+        template <typename S>
+            requires numeric_limits<S>::is_specialized
+        friend constexpr vec3 operator/(const vec3& lhs, S rhs) {
+            return vec3(static_cast<value_type>(lhs.c[0] / rhs), static_cast<value_type>(lhs.c[1] / rhs),
+                static_cast<value_type>(lhs.c[2] / rhs));
+        }
+
+        friend constexpr bool operator==(const vec3& lhs, const vec3& rhs) {
+            return lhs.c[0] == rhs.c[0] && lhs.c[1] == rhs.c[1] && lhs.c[2] == rhs.c[2];
+        }
+
+        friend constexpr bool operator!=(const vec3& lhs, const vec3& rhs) { return !(lhs == rhs); }
+
+    private:
+        value_type c[3];
+    };
+
+    // The result has the product units and scale, and a value type that can't overflow.
+    template <typename QA, typename QB>
+    constexpr auto dot(const vec3<QA>& a, const vec3<QB>& b) {
+        using result = detail::product_quantity<QA, QB, 3>;
+        using T = typename result::value_type;
+        return result(static_cast<T>(T(a.data()[0]) * T(b.data()[0]) + T(a.data()[1]) * T(b.data()[1]) +
+            T(a.data()[2]) * T(b.data()[2])));
+    }
+
+    template <typename QA, typename QB>
+    constexpr auto cross(const vec3<QA>& a, const vec3<QB>& b) {
+        using result = detail::product_quantity<QA, QB, 2>;
+        using T = typename result::value_type;
+        const auto* u = a.data();
+        const auto* v = b.data();
+        return vec3<result>(static_cast<T>(T(u[1]) * T(v[2]) - T(u[2]) * T(v[1])),
+            static_cast<T>(T(u[2]) * T(v[0]) - T(u[0]) * T(v[2])),
+            static_cast<T>(T(u[0]) * T(v[1]) - T(u[1]) * T(v[0])));
+    }
+
+    // The Euclidean length in the units and scale of the vector. Integer lengths are rounded down.
+    template <typename Q>
+    constexpr auto norm(const vec3<Q>& v) {
+        return sqrt(dot(v, v));
+    }
+
+    // A 3x3 matrix, stored row major.
+    template <typename Quantity>
+    class mat3 {
+    public:
+        using quantity_type = Quantity;
+        using value_type = typename Quantity::value_type;
+        using units = typename Quantity::units;
+        using scale = typename Quantity::scale;
+
+        constexpr mat3() = default;
+
+        constexpr mat3(const vec3<Quantity>& r0, const vec3<Quantity>& r1, const vec3<Quantity>& r2)
+            : m{ { r0.data()[0], r0.data()[1], r0.data()[2] }, { r1.data()[0], r1.data()[1], r1.data()[2] },
+                { r2.data()[0], r2.data()[1], r2.data()[2] } } {}
+
+        constexpr Quantity operator()(size_t row, size_t col) const { return m[row][col]; }
+
+        constexpr vec3<Quantity> row(size_t i) const { return { m[i][0], m[i][1], m[i][2] }; }
+
+        constexpr vec3<Quantity> col(size_t i) const { return { m[0][i], m[1][i], m[2][i] }; }
+
+        constexpr mat3 transpose() const { return mat3(col(0), col(1), col(2)); }
+
+        friend constexpr bool operator==(const mat3& lhs, const mat3& rhs) {
+            return lhs.row(0) == rhs.row(0) && lhs.row(1) == rhs.row(1) && lhs.row(2) == rhs.row(2);
+        }
+
+        friend constexpr bool operator!=(const mat3& lhs, const mat3& rhs) { return !(lhs == rhs); }
+
+    private:
+        value_type m[3][3];
+    };
+
+    // Exact products, with the units and scale of the element products.
+    template <typename QA, typename QB>
+    constexpr auto operator*(const mat3<QA>& a, const vec3<QB>& v) {
+        using result = detail::product_quantity<QA, QB, 3>;
+        return vec3<result>(dot(a.row(0), v), dot(a.row(1), v), dot(a.row(2), v));
+    }
+
+    template <typename QA, typename QB>
+    constexpr auto operator*(const mat3<QA>& a, const mat3<QB>& b) {
+        using result = detail::product_quantity<QA, QB, 3>;
+        const auto r = [&](size_t i) { return vec3<result>(dot(a.row(i), b.col(0)), dot(a.row(i), b.col(1)),
+            dot(a.row(i), b.col(2))); };
+        return mat3<result>(r(0), r(1), r(2));
+    }
+
+    namespace detail {
+        // log2(1 / Scale) if Scale is 1/2^k, otherwise -1.
+        template <typename Scale>
+        constexpr int reciprocal_shift() {
+            if (Scale::num != 1) {
+                return -1;
+            }
+            int k = 0;
+            while ((intmax_t(1) << k) < Scale::den && k < 62) {
+                ++k;
+            }
+            return (intmax_t(1) << k) == Scale::den ? k : -1;
+        }
+
+        // Accumulator of a rotation. For 16 bit matrices with a 1/2^k scale the rows of a rotation have unit length,
+        // so the sum of products is bounded by sqrt(3) times the largest product and fits in 32 bits.
+        template <typename R, typename Q>
+        using rotation_acc_t = conditional_t<
+            !numeric_limits<typename R::value_type>::is_integer || !numeric_limits<typename Q::value_type>::is_integer,
+            decltype(typename R::value_type() * typename Q::value_type()),
+            conditional_t<(sizeof(typename R::value_type) <= 2 && sizeof(typename Q::value_type) <= 2 &&
+                reciprocal_shift<typename R::scale>() >= 0 && reciprocal_shift<typename R::scale>() <= 16),
+                int32_t, intmax_t>>;
+
+        // Scales a row sum by the matrix scale and narrows it to T. Integers are rounded to nearest with ties
+        // towards positive infinity and saturated, which is what the SIMD kernels do too.
+        template <typename Scale, typename T, typename Acc>
+        constexpr T rotation_result(Acc s) {
+            if constexpr (!numeric_limits<T>::is_integer || !numeric_limits<Acc>::is_integer) {
+                return static_cast<T>(s * Scale::num / Scale::den);
+            }
+            else if constexpr (reciprocal_shift<Scale>() > 0) {
+                constexpr int k = reciprocal_shift<Scale>();
+                return saturate<T>((intmax_t(s) + (intmax_t(1) << (k - 1))) >> k);
+            }
+            else {
+                return saturate<T>(ratio_scale<Scale, intmax_t, float_round_style::round_to_nearest>(intmax_t(s)));
+            }
+        }
+    }  // namespace detail
+
+    // Rotates v by the dimensionless matrix r and returns the result in the units and scale of v. Integer matrices
+    // are typically fixed point, e.g. int16_t with a scale of 1/2^15. Every row of r must have at most unit length,
+    // which is true for rotation matrices.
+    template <typename R, typename Q>
+    constexpr vec3<Q> rotate(const mat3<R>& r, const vec3<Q>& v) {
+        static_assert(is_same_v<typename R::units, ctd::units::unity>, "A rotation matrix is dimensionless");
+        using acc = detail::rotation_acc_t<R, Q>;
+        using T = typename Q::value_type;
+        const auto row = [&](size_t i) {
+            const acc s = acc(r(i, 0).count()) * acc(v.data()[0]) + acc(r(i, 1).count()) * acc(v.data()[1]) +
+                acc(r(i, 2).count()) * acc(v.data()[2]);
+            return Q(detail::rotation_result<typename R::scale, T>(s));
+        };
+        return vec3<Q>(row(0), row(1), row(2));
+    }
+
+    namespace detail {
+        template <typename R, typename Q>
+        void rotate_scalar(const mat3<R>& r, const vec3<Q>* in, vec3<Q>* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = rotate(r, in[i]);
+            }
+        }
+
+        template <typename R, typename Q>
+        constexpr bool rotate_int16_kernel = is_same_v<typename R::value_type, int16_t> &&
+            is_same_v<typename Q::value_type, int16_t> && reciprocal_shift<typename R::scale>() > 0 &&
+            reciprocal_shift<typename R::scale>() <= 16;
+
+        template <typename R, typename Q>
+        constexpr bool rotate_float_kernel = is_same_v<typename R::value_type, float> &&
+            is_same_v<typename Q::value_type, float> && is_same_v<typename R::scale, ratio<1>>;
+
+#if defined(CTD_LINALG_SSE2)
+        // Two vectors per iteration. Each is widened to (x, y, z, 0) in one half of a register, pmaddwd with a row
+        // repeated in both halves gives the partial sums, and the results are rounded, saturated and packed back.
+        template <int K, typename R, typename Q>
+        void rotate_int16(const mat3<R>& r, const vec3<Q>* in, vec3<Q>* out, size_t n) {
+            const auto row = [&](int i) {
+                return _mm_setr_epi16(r(i, 0).count(), r(i, 1).count(), r(i, 2).count(), 0, r(i, 0).count(),
+                    r(i, 1).count(), r(i, 2).count(), 0);
+            };
+            const __m128i r0 = row(0);
+            const __m128i r1 = row(1);
+            const __m128i r2 = row(2);
+            const __m128i lo3 = _mm_setr_epi16(-1, -1, -1, 0, 0, 0, 0, 0);
+            const __m128i hi3 = _mm_setr_epi16(0, 0, 0, 0, -1, -1, -1, 0);
+            const __m128i mid3 = _mm_setr_epi16(0, 0, 0, -1, -1, -1, 0, 0);
+            const __m128i round = _mm_set1_epi32(1 << (K - 1));
+
+            size_t i = 0;
+            // The 16 byte load reads 4 bytes of the third vector, so it must exist.
+            for (; i + 3 <= n; i += 2) {
+                const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                const __m128i a = _mm_or_si128(_mm_and_si128(l, lo3), _mm_and_si128(_mm_slli_si128(l, 2), hi3));
+
+                // Lanes 0 and 2 hold the row sums of the first and second vector.
+                const auto sums = [&](__m128i rr) {
+                    const __m128i p = _mm_madd_epi16(a, rr);
+                    return _mm_add_epi32(p, _mm_shuffle_epi32(p, _MM_SHUFFLE(2, 3, 0, 1)));
+                };
+                const __m128i s0 = sums(r0);
+                const __m128i s1 = sums(r1);
+                const __m128i s2 = sums(r2);
+
+                __m128i v0 = _mm_unpacklo_epi64(_mm_unpacklo_epi32(s0, s1), s2);
+                __m128i v1 = _mm_unpacklo_epi64(_mm_unpackhi_epi32(s0, s1), _mm_srli_si128(s2, 8));
+                v0 = _mm_srai_epi32(_mm_add_epi32(v0, round), K);
+                v1 = _mm_srai_epi32(_mm_add_epi32(v1, round), K);
+
+                const __m128i p = _mm_packs_epi32(v0, v1);
+                const __m128i c = _mm_or_si128(_mm_and_si128(p, lo3), _mm_and_si128(_mm_srli_si128(p, 2), mid3));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), c);
+                const int32_t last = _mm_cvtsi128_si32(_mm_srli_si128(c, 8));
+                std::memcpy(reinterpret_cast<char*>(out + i) + 8, &last, sizeof(last));
+            }
+            rotate_scalar(r, in + i, out + i, n - i);
+        }
+
+        template <typename R, typename Q>
+        void rotate_float(const mat3<R>& r, const vec3<Q>* in, vec3<Q>* out, size_t n) {
+            const __m128 c0 = _mm_setr_ps(r(0, 0).count(), r(1, 0).count(), r(2, 0).count(), 0);
+            const __m128 c1 = _mm_setr_ps(r(0, 1).count(), r(1, 1).count(), r(2, 1).count(), 0);
+            const __m128 c2 = _mm_setr_ps(r(0, 2).count(), r(1, 2).count(), r(2, 2).count(), 0);
+            for (size_t i = 0; i < n; ++i) {
+                const float* v = in[i].data();
+                const __m128 s = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(v[0])),
+                    _mm_mul_ps(c1, _mm_set1_ps(v[1]))), _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+                float* o = out[i].data();
+                _mm_storel_pi(reinterpret_cast<__m64*>(o), s);
+                _mm_store_ss(o + 2, _mm_movehl_ps(s, s));
+            }
+        }
+#elif defined(CTD_LINALG_NEON)
+        // One vector per iteration, multiplying the columns of the matrix by the components and accumulating.
+        // vqrshrn rounds, shifts and saturates like rotation_result().
+        template <int K, typename R, typename Q>
+        void rotate_int16(const mat3<R>& r, const vec3<Q>* in, vec3<Q>* out, size_t n) {
+            const auto col = [&](int j) {
+                const int16_t c[4] = { r(0, j).count(), r(1, j).count(), r(2, j).count(), 0 };
+                return vld1_s16(c);
+            };
+            const int16x4_t c0 = col(0);
+            const int16x4_t c1 = col(1);
+            const int16x4_t c2 = col(2);
+            for (size_t i = 0; i < n; ++i) {
+                const int16_t* v = in[i].data();
+                int32x4_t s = vmull_n_s16(c0, v[0]);
+                s = vmlal_n_s16(s, c1, v[1]);
+                s = vmlal_n_s16(s, c2, v[2]);
+                const int16x4_t res = vqrshrn_n_s32(s, K);
+                int16_t* o = out[i].data();
+                vst1_lane_s16(o, res, 0);
+                vst1_lane_s16(o + 1, res, 1);
+                vst1_lane_s16(o + 2, res, 2);
+            }
+        }
+
+        template <typename R, typename Q>
+        void rotate_float(const mat3<R>& r, const vec3<Q>* in, vec3<Q>* out, size_t n) {
+            const auto col = [&](int j) {
+                const float c[4] = { r(0, j).count(), r(1, j).count(), r(2, j).count(), 0 };
+                return vld1q_f32(c);
+            };
+            const float32x4_t c0 = col(0);
+            const float32x4_t c1 = col(1);
+            const float32x4_t c2 = col(2);
+            for (size_t i = 0; i < n; ++i) {
+                const float* v = in[i].data();
+                const float32x4_t s = vaddq_f32(vaddq_f32(vmulq_n_f32(c0, v[0]), vmulq_n_f32(c1, v[1])),
+                    vmulq_n_f32(c2, v[2]));
+                float* o = out[i].data();
+                vst1_f32(o, vget_low_f32(s));
+                vst1q_lane_f32(o + 2, s, 2);
+            }
+        }
+#endif
+    }  // namespace detail
+
+    // Rotates n vectors, 'in' and 'out' may be the same array. int16_t vectors with an int16_t matrix in a 1/2^k
+    // scale, and float vectors with a float matrix, use SIMD kernels where available. The results are identical to
+    // the single vector rotate() for integers.
+    template <typename R, typename Q>
+    void rotate(const mat3<R>& r, const vec3<Q>* in, vec3<Q>* out, size_t n) {
+        static_assert(sizeof(vec3<Q>) == 3 * sizeof(typename Q::value_type), "vec3 must be tightly packed");
+#if defined(CTD_LINALG_SSE2) || defined(CTD_LINALG_NEON)
+        if constexpr (detail::rotate_int16_kernel<R, Q>) {
+            detail::rotate_int16<detail::reciprocal_shift<typename R::scale>()>(r, in, out, n);
+            return;
+        }
+        else if constexpr (detail::rotate_float_kernel<R, Q>) {
+            detail::rotate_float(r, in, out, n);
+            return;
+        }
+#endif
+        detail::rotate_scalar(r, in, out, n);
+    }
+}  // namespace ctd
+
+#endif
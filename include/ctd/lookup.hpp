@@ -0,0 +1,199 @@
+/*
+* This file provides piecewise linear interpolation tables that map one integer quantity to another, for example
+* thermistor or battery discharge curves. Tables are constexpr so that they are placed in read only memory. On a
+* uniform grid the segment is found with a single multiply and shift, otherwise with a branch free binary search.
+* Interpolation uses fixed point slopes prepared during construction, so there is no division at run time.
+*/
+#ifndef CTD_LOOKUP_HPP
+#define CTD_LOOKUP_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "constant_evaluation.hpp"
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // The product type and number of fraction bits for interpolating between two Y counts. Narrow Y use 32 bit
+        // products, the fraction bits are as many as fit next to a difference of two Y values.
+        template <typename Y>
+        struct interpolation_traits {
+            using product_type = conditional_t<(numeric_limits<Y>::digits <= 15), int32_t, int64_t>;
+            constexpr static int frac_bits = numeric_limits<product_type>::digits - 1 - (numeric_limits<Y>::digits + 1);
+        };
+
+        template <typename Y, typename P>
+        constexpr Y interpolate(Y y0, Y y1, P frac, int frac_bits) {
+            const P dy = P(y1) - P(y0);
+            return static_cast<Y>(y0 + ((dy * frac + (P(1) << (frac_bits - 1))) >> frac_bits));
+        }
+    }  // namespace detail
+
+    // A table of N values on the grid Start, Start + Step, ..., Start + (N - 1) * Step, where Start and Step are
+    // ratios in the units of X, e.g. ratio<-40> and ratio<5> for every 5 degrees from -40 degrees Celsius. Inputs
+    // outside of the grid return the first or last value.
+    template <typename X, typename Y, size_t N, typename Start, typename Step>
+    class uniform_interpolation_table {
+        static_assert(N >= 2, "A table needs at least two points");
+        static_assert(Step::num > 0, "The step must be positive");
+
+        using x_type = typename X::value_type;
+        using y_type = typename Y::value_type;
+        static_assert(numeric_limits<x_type>::is_integer && numeric_limits<y_type>::is_integer,
+            "Interpolation tables are for integer quantities");
+
+        using traits = detail::interpolation_traits<y_type>;
+        using product_type = typename traits::product_type;
+        constexpr static int frac_bits = traits::frac_bits;
+
+        // The grid in counts of X, start = sn / sd and step = dn / dd. The position on the grid is then
+        // (x * sd - sn) * dd / (sd * dn), which is computed as a multiply and shift in 64 bits. The multiplier is
+        // narrowed for wide X so that the product can't overflow.
+        using start = ratio_divide<Start, typename X::scale>;
+        using step = ratio_divide<Step, typename X::scale>;
+        constexpr static int x_digits = numeric_limits<x_type>::digits;
+        constexpr static int position_bits = x_digits < 30 ? 31 : 60 - x_digits;
+        using position = ratio_multiply_shift<ratio_divide<ratio<step::den>, ratio<start::den * step::num>>,
+            position_bits>;
+
+    public:
+        using input_type = X;
+        using output_type = Y;
+
+        constexpr uniform_interpolation_table(const y_type (&values)[N]) : y() {
+            for (size_t i = 0; i < N; ++i) {
+                y[i] = values[i];
+            }
+        }
+
+        constexpr Y operator()(X x) const {
+            const int64_t u = int64_t(x.count()) * start::den - start::num;
+            if (u <= 0) {
+                return y[0];
+            }
+            const int64_t t = u * position::multiplier;
+            const int64_t index = t >> position::shift;
+            if (index >= int64_t(N - 1)) {
+                return y[N - 1];
+            }
+            constexpr int64_t mask = (int64_t(1) << frac_bits) - 1;
+            product_type frac;
+            if constexpr (position::shift >= frac_bits) {
+                frac = static_cast<product_type>((t >> (position::shift - frac_bits)) & mask);
+            }
+            else {
+                frac = static_cast<product_type>((t << (frac_bits - position::shift)) & mask);
+            }
+            return detail::interpolate(y[index], y[index + 1], frac, frac_bits);
+        }
+
+        constexpr Y operator[](size_t i) const { return y[i]; }
+
+        constexpr static size_t size() { return N; }
+
+    private:
+        y_type y[N];
+    };
+
+    // A table of N points with strictly increasing x. Inputs outside of [x[0], x[N - 1]] return the first or last
+    // value.
+    template <typename X, typename Y, size_t N>
+    class interpolation_table {
+        static_assert(N >= 2, "A table needs at least two points");
+
+        using x_type = typename X::value_type;
+        using y_type = typename Y::value_type;
+        static_assert(numeric_limits<x_type>::is_integer && numeric_limits<y_type>::is_integer,
+            "Interpolation tables are for integer quantities");
+
+        // Slopes of 16 bit Y over integer X are at most 17 bits before the fraction bits are added.
+        using slope_type = conditional_t<(numeric_limits<y_type>::digits <= 16), int32_t, int64_t>;
+
+    public:
+        using input_type = X;
+        using output_type = Y;
+
+        // The slopes of all segments are computed here, as fixed point numbers with as many fraction bits as the
+        // steepest segment allows. A strictly increasing x is checked: in a constant evaluation a table that isn't
+        // fails to compile, at run time it is rejected, valid() is false and every lookup returns the first value.
+        constexpr interpolation_table(const x_type (&xs)[N], const y_type (&ys)[N])
+            : x(), y(), slope(), shift(), increasing(true) {
+            for (size_t i = 0; i < N; ++i) {
+                x[i] = xs[i];
+                y[i] = ys[i];
+                if (i > 0 && x[i] <= x[i - 1]) {
+                    increasing = false;
+                }
+            }
+            if (!increasing) {
+                detail::fail_constant_evaluation();
+                // All values and slopes the same, so that the search, whatever it finds, returns the first value.
+                for (size_t i = 0; i < N; ++i) {
+                    y[i] = ys[0];
+                }
+                return;
+            }
+            uint64_t steepest = 0;
+            uint64_t widest = 0;
+            for (size_t i = 0; i + 1 < N; ++i) {
+                const int64_t dy = int64_t(y[i + 1]) - int64_t(y[i]);
+                const uint64_t dx = uint64_t(int64_t(x[i + 1]) - int64_t(x[i]));
+                const uint64_t s = uint64_t(dy < 0 ? -dy : dy) / dx + 1;
+                steepest = s > steepest ? s : steepest;
+                widest = dx > widest ? dx : widest;
+            }
+            // Both the slope and its product with the distance into the segment must fit.
+            const uint64_t slope_max = uint64_t(numeric_limits<slope_type>::max());
+            const uint64_t product_max = uint64_t(INT64_MAX) / widest;
+            const uint64_t limit = slope_max < product_max ? slope_max : product_max;
+            while (shift < 30 && (steepest << (shift + 1)) <= limit) {
+                ++shift;
+            }
+            for (size_t i = 0; i + 1 < N; ++i) {
+                slope[i] = static_cast<slope_type>(detail::fixed_point_round(int64_t(y[i + 1]) - int64_t(y[i]),
+                    int64_t(x[i + 1]) - int64_t(x[i]), shift));
+            }
+        }
+
+        constexpr Y operator()(X q) const {
+            const x_type v = q.count();
+            if (v <= x[0]) {
+                return y[0];
+            }
+            if (v >= x[N - 1]) {
+                return y[N - 1];
+            }
+            // Branch free lower bound, the loop runs log2(N) times and the select compiles to a conditional move.
+            size_t base = 0;
+            size_t n = N;
+            while (n > 1) {
+                const size_t half = n / 2;
+                base = x[base + half] <= v ? base + half : base;
+                n -= half;
+            }
+            const int64_t dx = int64_t(v) - int64_t(x[base]);
+            if (shift == 0) {
+                return static_cast<y_type>(y[base] + dx * slope[base]);
+            }
+            return static_cast<y_type>(y[base] + ((dx * slope[base] + (int64_t(1) << (shift - 1))) >> shift));
+        }
+
+        constexpr static size_t size() { return N; }
+
+        // False if the table was built at run time from x values that aren't strictly increasing.
+        constexpr bool valid() const { return increasing; }
+
+    private:
+        x_type x[N];
+        y_type y[N];
+        slope_type slope[N - 1];
+        int shift;
+        bool increasing;
+    };
+}  // namespace ctd
+
+#endif
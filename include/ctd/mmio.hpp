@@ -0,0 +1,114 @@
+/*
+* This file provides memory mapped register access that reads and writes registers as quantities, e.g. an ADC data
+* register as a voltage<uint16_t, ratio<3300, 4096 * 1000>>. Each access is exactly one volatile read or write of
+* the register, and bit fields are extracted with compile time shifts and masks, so the generated code is the same as
+* for a hand written volatile access. The address is a template argument for drivers, or a pointer given at run time,
+* which lets host tests back the register with ordinary memory.
+*/
+#ifndef CTD_MMIO_HPP
+#define CTD_MMIO_HPP
+
+#include <cstdint>
+
+#include "limits.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // The address of an mmio_quantity whose register pointer is given to its constructor.
+    inline constexpr uintptr_t dynamic_address = ~uintptr_t(0);
+
+    namespace detail {
+        template <uintptr_t Address, typename RawType>
+        struct mmio_location {
+            static volatile RawType* reg() { return reinterpret_cast<volatile RawType*>(Address); }
+        };
+
+        template <typename RawType>
+        struct mmio_location<dynamic_address, RawType> {
+            volatile RawType* p;
+            volatile RawType* reg() const { return p; }
+        };
+    }  // namespace detail
+
+    // The RawType register at Address, or at a run time address if Address is dynamic_address, holding a count of
+    // Scale in Units in bits [Shift, Shift + Width). A signed RawType sign extends the field.
+    template <uintptr_t Address, typename RawType, typename Units, typename Scale, int Shift = 0,
+        int Width = numeric_limits<RawType>::digits + numeric_limits<RawType>::is_signed - Shift>
+    class mmio_quantity : detail::mmio_location<Address, RawType> {
+        static_assert(numeric_limits<RawType>::is_integer, "Registers must be of integer type");
+        constexpr static int raw_bits = numeric_limits<RawType>::digits + numeric_limits<RawType>::is_signed;
+        static_assert(Shift >= 0 && Width >= 1 && Shift + Width <= raw_bits, "The field must be within the register");
+
+        using location = detail::mmio_location<Address, RawType>;
+        using unsigned_type = conditional_t<(raw_bits <= 8), uint8_t, conditional_t<(raw_bits <= 16), uint16_t,
+            conditional_t<(raw_bits <= 32), uint32_t, uint64_t>>>;
+
+    public:
+        using value_type = RawType;
+        using quantity_type = quantity<RawType, Units, Scale>;
+
+        constexpr static bool is_field = Width < raw_bits;
+
+        mmio_quantity()
+            requires(Address != dynamic_address)
+        = default;
+
+        explicit mmio_quantity(volatile RawType* reg)
+            requires(Address == dynamic_address)
+            : location{ reg } {}
+
+        // One volatile read.
+        quantity_type load() const { return quantity_type(extract(*location::reg())); }
+
+        // One volatile write for a whole register. A field is a read-modify-write, which isn't atomic with respect to
+        // interrupts that write the same register.
+        void store(quantity_type q) const {
+            volatile RawType* r = location::reg();
+            if constexpr (is_field) {
+                const unsigned_type old = static_cast<unsigned_type>(*r);
+                *r = static_cast<RawType>((old & ~field_mask) | ((unsigned_type(q.count()) << Shift) & field_mask));
+            }
+            else {
+                *r = q.count();
+            }
+        }
+
+        // Reads as a quantity of any scale of the same units, converted after the read.
+        template <typename ValueType, typename OtherScale>
+        operator quantity<ValueType, Units, OtherScale>() const {
+            return load();
+        }
+
+        // Quantities of other scales of the same units are converted to Scale before the write, rounding toward zero.
+        const mmio_quantity& operator=(quantity_type q) const {
+            store(q);
+            return *this;
+        }
+
+        volatile RawType* address() const { return location::reg(); }
+
+    private:
+        constexpr static unsigned_type value_mask = static_cast<unsigned_type>(
+            Width == raw_bits ? ~unsigned_type(0) : unsigned_type((unsigned_type(1) << (Width % raw_bits)) - 1));
+        constexpr static unsigned_type field_mask = static_cast<unsigned_type>(value_mask << Shift);
+
+        constexpr static RawType extract(RawType raw) {
+            if constexpr (!is_field) {
+                return raw;
+            }
+            else {
+                const unsigned_type x = static_cast<unsigned_type>((unsigned_type(raw) >> Shift) & value_mask);
+                if constexpr (numeric_limits<RawType>::is_signed) {
+                    const unsigned_type sign = unsigned_type(1) << (Width - 1);
+                    return static_cast<RawType>(static_cast<RawType>(x ^ sign) - static_cast<RawType>(sign));
+                }
+                else {
+                    return static_cast<RawType>(x);
+                }
+            }
+        }
+    };
+}  // namespace ctd
+
+#endif
@@ -4,6 +4,9 @@
 #ifndef CTD_NUMERIC_IMPL_HPP
 #define CTD_NUMERIC_IMPL_HPP
 
+#include "algorithm.hpp"
+#include "cmath.hpp"
+
 namespace ctd_impl {
 
     template <typename M, typename N>
@@ -37,12 +40,13 @@ namespace ctd_impl {
         return m << shift;
     }
 
+    // Like std::midpoint, the result is rounded toward 'a'.
     template <class T>
-    constexpr const T midpoint(T smaller, T bigger) {
-        if (smaller > bigger) {
-            return avg(bigger, smaller);
+    constexpr const T midpoint(T a, T b) {
+        if (a > b) {
+            return a - (a - b) / 2;
         }
-        return smaller + (bigger - smaller) / 2;
+        return a + (b - a) / 2;
     }
 }
 
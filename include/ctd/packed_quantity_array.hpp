@@ -0,0 +1,222 @@
+/*
+* This file provides a fixed size array of quantities stored at an exact bit width, e.g. 10, 12 or 14 bit ADC samples,
+* which take 5/8, 3/4 or 7/8 of the RAM of an array of 16 bit quantities. Sample i occupies bits [i * Bits, (i + 1) *
+* Bits) of a little-endian byte array, so there's no padding between samples and the layout is the same on every
+* target. Single samples are read and written with shifts and masks, and bulk unpacking into an array of quantities
+* uses SSE2 or NEON where available for 9 to 16 bit samples.
+*/
+#ifndef CTD_PACKED_QUANTITY_ARRAY_HPP
+#define CTD_PACKED_QUANTITY_ARRAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(HAS_STL) && defined(__SSE2__)
+#include <emmintrin.h>
+#define CTD_PACKED_ARRAY_SSE2
+#elif defined(HAS_STL) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CTD_PACKED_ARRAY_NEON
+#endif
+
+#include "limits.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // The smallest integer type with at least Bits bits.
+        template <int Bits, bool Signed>
+        using packed_value_t = conditional_t<(Bits <= 8), conditional_t<Signed, int8_t, uint8_t>,
+            conditional_t<(Bits <= 16), conditional_t<Signed, int16_t, uint16_t>,
+                conditional_t<Signed, int32_t, uint32_t>>>;
+    }  // namespace detail
+
+    // N quantities with Units and Scale, each stored in Bits bits. Samples are unsigned unless Signed is true, in
+    // which case they are two's complement. The value type of the quantities is the smallest integer type with Bits
+    // bits. Values that don't fit in Bits bits are truncated to their low Bits bits when stored.
+    template <int Bits, typename Units, typename Scale, size_t N, bool Signed = false>
+    class packed_quantity_array {
+        static_assert(Bits >= 1 && Bits <= 32, "Samples must be 1 to 32 bits wide");
+        static_assert(N > 0, "The array must hold at least one sample");
+
+    public:
+        using value_type = detail::packed_value_t<Bits, Signed>;
+        using quantity_type = quantity<value_type, Units, Scale>;
+
+        constexpr static int bits = Bits;
+        // The storage, with no padding other than to the next whole byte.
+        constexpr static size_t storage_bytes = (N * size_t(Bits) + 7) / 8;
+
+        constexpr packed_quantity_array() : data_() {}
+
+        constexpr static size_t size() { return N; }
+
+        constexpr quantity_type get(size_t index) const { return quantity_type(extend(read(index * Bits))); }
+
+        constexpr quantity_type operator[](size_t index) const { return get(index); }
+
+        constexpr void set(size_t index, quantity_type q) {
+            const size_t bit = index * Bits;
+            const size_t first = bit / 8;
+            const int shift = int(bit % 8);
+            const int span = (shift + Bits + 7) / 8;
+            const acc_type mask = value_mask << shift;
+            const acc_type value = (acc_type(static_cast<raw_type>(q.count())) << shift) & mask;
+            for (int k = 0; k < span; ++k) {
+                const uint8_t m = static_cast<uint8_t>(mask >> (8 * k));
+                data_[first + k] = static_cast<uint8_t>((data_[first + k] & ~m) | uint8_t(value >> (8 * k)));
+            }
+        }
+
+        // Stores n quantities from 'in' at [first, first + n).
+        constexpr void pack(size_t first, size_t n, const quantity_type* in) {
+            for (size_t i = 0; i < n; ++i) {
+                set(first + i, in[i]);
+            }
+        }
+
+        constexpr void pack(const quantity_type* in) { pack(0, N, in); }
+
+        // Unpacks the n quantities at [first, first + n) into out.
+        void unpack(size_t first, size_t n, quantity_type* out) const {
+#if defined(CTD_PACKED_ARRAY_SSE2) || defined(CTD_PACKED_ARRAY_NEON)
+            if constexpr (Bits > 8 && Bits <= 16) {
+                // Groups of 8 samples start on a byte boundary, unpack up to the first one sequentially.
+                const size_t head = (8 - first % 8) % 8 < n ? (8 - first % 8) % 8 : n;
+                unpack_sequential(first, head, out);
+                first += head;
+                out += head;
+                n -= head;
+                // The last samples are unpacked sequentially too, the vector loads read up to 3 bytes past a group.
+                size_t groups = n / 8;
+                while (groups > 0 && (first / 8 + groups) * Bits + 3 > storage_bytes) {
+                    --groups;
+                }
+                for (size_t g = 0; g < groups; ++g) {
+                    unpack_group(data_ + (first / 8 + g) * Bits, out + 8 * g);
+                }
+                first += 8 * groups;
+                out += 8 * groups;
+                n -= 8 * groups;
+            }
+#endif
+            unpack_sequential(first, n, out);
+        }
+
+        void unpack(quantity_type* out) const { unpack(0, N, out); }
+
+        constexpr const uint8_t* data() const { return data_; }
+        constexpr uint8_t* data() { return data_; }
+
+    private:
+        using raw_type = conditional_t<(Bits <= 8), uint8_t, conditional_t<(Bits <= 16), uint16_t, uint32_t>>;
+        // Holds a sample and the up to 7 bits before it in its first byte.
+        using acc_type = conditional_t<(Bits <= 24), uint32_t, uint64_t>;
+
+        constexpr static acc_type value_mask = (acc_type(1) << Bits) - 1;
+
+        constexpr static value_type extend(acc_type x) {
+            if constexpr (Signed) {
+                const acc_type sign = acc_type(1) << (Bits - 1);
+                return static_cast<value_type>(static_cast<int64_t>(x ^ sign) - static_cast<int64_t>(sign));
+            }
+            else {
+                return static_cast<value_type>(x);
+            }
+        }
+
+        // The sample starting at 'bit', reading only the bytes that hold it.
+        constexpr acc_type read(size_t bit) const {
+            const uint8_t* p = data_ + bit / 8;
+            const int shift = int(bit % 8);
+            const int span = (shift + Bits + 7) / 8;
+            acc_type x = 0;
+            for (int k = 0; k < span; ++k) {
+                x |= acc_type(p[k]) << (8 * k);
+            }
+            return (x >> shift) & value_mask;
+        }
+
+        // Streams the bytes through a bit buffer, so each byte is read once. On 8 bit targets this is the fastest way.
+        void unpack_sequential(size_t first, size_t n, quantity_type* out) const {
+            if (n == 0) {
+                return;
+            }
+            const size_t bit = first * Bits;
+            const uint8_t* p = data_ + bit / 8;
+            acc_type acc = *p++ >> (bit % 8);
+            int filled = 8 - int(bit % 8);
+            for (size_t i = 0; i < n; ++i) {
+                // The bytes of the last sample are the last ones read, so this never reads past the storage.
+                while (filled < Bits) {
+                    acc |= acc_type(*p++) << filled;
+                    filled += 8;
+                }
+                out[i] = quantity_type(extend(acc & value_mask));
+                acc >>= Bits;
+                filled -= Bits;
+            }
+        }
+
+#if defined(CTD_PACKED_ARRAY_SSE2) || defined(CTD_PACKED_ARRAY_NEON)
+        // Sample i of a group of 8 is in the 32 bit word at byte i * Bits / 8, shifted left by i * Bits % 8.
+        constexpr static int byte_of(int i) { return i * Bits / 8; }
+        constexpr static int shift_of(int i) { return i * Bits % 8; }
+
+        static uint32_t load32(const uint8_t* p) {
+            return uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16 | uint32_t(p[3]) << 24;
+        }
+
+        // 16 bit results keep their bit pattern through the signed saturating pack after this sign extension.
+        constexpr static int extend_shift = 32 - (Signed ? Bits : 16);
+#endif
+
+#if defined(CTD_PACKED_ARRAY_SSE2)
+        // SSE2 has no per lane shifts. Each sample and the bits below it in its word has at most 23 bits, so it
+        // converts exactly to float, where the shift is an exact multiplication by a power of two.
+        static __m128i unpack_quad(const uint8_t* p, int i) {
+            const __m128i words = _mm_set_epi32(int32_t(load32(p + byte_of(i + 3))),
+                int32_t(load32(p + byte_of(i + 2))), int32_t(load32(p + byte_of(i + 1))),
+                int32_t(load32(p + byte_of(i))));
+            const __m128i mask = _mm_set_epi32(int32_t(value_mask << shift_of(i + 3)),
+                int32_t(value_mask << shift_of(i + 2)), int32_t(value_mask << shift_of(i + 1)),
+                int32_t(value_mask << shift_of(i)));
+            const __m128 scale = _mm_set_ps(1.0f / float(1 << shift_of(i + 3)), 1.0f / float(1 << shift_of(i + 2)),
+                1.0f / float(1 << shift_of(i + 1)), 1.0f / float(1 << shift_of(i)));
+            const __m128i x = _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(words, mask)), scale));
+            return _mm_srai_epi32(_mm_slli_epi32(x, extend_shift), extend_shift);
+        }
+
+        static void unpack_group(const uint8_t* p, quantity_type* out) {
+            value_type v[8];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(v), _mm_packs_epi32(unpack_quad(p, 0), unpack_quad(p, 4)));
+            for (int i = 0; i < 8; ++i) {
+                out[i] = quantity_type(v[i]);
+            }
+        }
+#elif defined(CTD_PACKED_ARRAY_NEON)
+        // As the SSE2 version, but NEON shifts each lane by its own count, negative for right shifts.
+        static int32x4_t unpack_quad(const uint8_t* p, int i) {
+            const uint32_t w[4] = { load32(p + byte_of(i)), load32(p + byte_of(i + 1)), load32(p + byte_of(i + 2)),
+                load32(p + byte_of(i + 3)) };
+            const int32_t s[4] = { -shift_of(i), -shift_of(i + 1), -shift_of(i + 2), -shift_of(i + 3) };
+            const uint32x4_t x = vandq_u32(vshlq_u32(vld1q_u32(w), vld1q_s32(s)), vdupq_n_u32(uint32_t(value_mask)));
+            return vshrq_n_s32(vshlq_n_s32(vreinterpretq_s32_u32(x), extend_shift), extend_shift);
+        }
+
+        static void unpack_group(const uint8_t* p, quantity_type* out) {
+            value_type v[8];
+            const int16x8_t x = vcombine_s16(vmovn_s32(unpack_quad(p, 0)), vmovn_s32(unpack_quad(p, 4)));
+            vst1q_u8(reinterpret_cast<uint8_t*>(v), vreinterpretq_u8_s16(x));
+            for (int i = 0; i < 8; ++i) {
+                out[i] = quantity_type(v[i]);
+            }
+        }
+#endif
+
+        uint8_t data_[storage_bytes];
+    };
+}  // namespace ctd
+
+#endif
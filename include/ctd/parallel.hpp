@@ -0,0 +1,267 @@
+/*
+* This file provides parallel reduce, transform and minmax over contiguous ranges of quantities, for host tools that
+* process large logs. Ranges are split into fixed size chunks that the threads of a thread_pool claim one at a time, so
+* threads that finish early take over the remaining work. Partial results are kept per chunk and merged in order, so
+* the results don't depend on the number of threads. Defining CTD_PARALLEL_STD_EXECUTION uses the standard parallel
+* algorithms with std::execution::par_unseq instead, which is only parallel if the standard library has a backend for
+* it, e.g. libstdc++ with TBB linked in. This file needs the standard library.
+*/
+#ifndef CTD_PARALLEL_HPP
+#define CTD_PARALLEL_HPP
+
+#ifndef HAS_STL
+#error "parallel.hpp needs threads from the standard library"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef CTD_PARALLEL_STD_EXECUTION
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <numeric>
+#endif
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace parallel {
+        // A fixed set of worker threads that run one job at a time together with the thread that submits it.
+        class thread_pool {
+        public:
+            // 'threads' is the total number of threads working on a job, including the calling thread.
+            explicit thread_pool(unsigned threads = std::thread::hardware_concurrency()) {
+                for (unsigned i = 1; i < threads; ++i) {
+                    workers.emplace_back([this] { work(); });
+                }
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator=(const thread_pool&) = delete;
+
+            ~thread_pool() {
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    stop = true;
+                }
+                wake.notify_all();
+                for (auto& t : workers) {
+                    t.join();
+                }
+            }
+
+            unsigned size() const { return unsigned(workers.size()) + 1; }
+
+            // Calls f(i) for every i in [0, n) and returns when all calls are done. The calls run concurrently on a
+            // const f and must not throw, or call run() on the same pool. Jobs submitted from several threads run one
+            // after the other.
+            template <typename F>
+            void run(size_t n, const F& f) {
+                std::lock_guard<std::mutex> serialize(submit);
+                const job_type invoke = [](const void* context, size_t i) { (*static_cast<const F*>(context))(i); };
+                {
+                    std::lock_guard<std::mutex> lock(m);
+                    job = invoke;
+                    job_context = &f;
+                    job_size = n;
+                    next.store(0, std::memory_order_relaxed);
+                    busy = unsigned(workers.size());
+                    ++generation;
+                }
+                wake.notify_all();
+                claim(invoke, &f, n);
+                std::unique_lock<std::mutex> lock(m);
+                done.wait(lock, [this] { return busy == 0; });
+            }
+
+        private:
+            using job_type = void (*)(const void*, size_t);
+
+            void claim(job_type f, const void* context, size_t n) {
+                for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < n;
+                    i = next.fetch_add(1, std::memory_order_relaxed)) {
+                    f(context, i);
+                }
+            }
+
+            void work() {
+                size_t seen = 0;
+                std::unique_lock<std::mutex> lock(m);
+                for (;;) {
+                    wake.wait(lock, [&] { return stop || generation != seen; });
+                    if (stop) {
+                        return;
+                    }
+                    seen = generation;
+                    const job_type f = job;
+                    const void* context = job_context;
+                    const size_t n = job_size;
+                    lock.unlock();
+                    claim(f, context, n);
+                    lock.lock();
+                    if (--busy == 0) {
+                        done.notify_one();
+                    }
+                }
+            }
+
+            std::vector<std::thread> workers;
+            std::mutex submit;
+            std::mutex m;
+            std::condition_variable wake;
+            std::condition_variable done;
+            job_type job = nullptr;
+            const void* job_context = nullptr;
+            size_t job_size = 0;
+            std::atomic<size_t> next{ 0 };
+            size_t generation = 0;
+            unsigned busy = 0;
+            bool stop = false;
+        };
+
+        // A pool with one thread per hardware thread, started on first use.
+        inline thread_pool& default_pool() {
+            static thread_pool pool;
+            return pool;
+        }
+
+        namespace detail {
+            // Large enough that claiming a chunk costs nothing in comparison, small enough to balance the load.
+            inline constexpr size_t chunk_size = size_t(1) << 16;
+
+            constexpr size_t chunk_count(size_t n) { return (n + chunk_size - 1) / chunk_size; }
+
+            // Partial sums of integer counts are 64 bit. A chunk of 32 bit counts can't overflow them.
+            template <typename V>
+            using accumulator_t = conditional_t<numeric_limits<V>::is_integer,
+                conditional_t<numeric_limits<V>::is_signed, int64_t, uint64_t>,
+                conditional_t<(sizeof(V) > sizeof(double)), V, double>>;
+
+            // Converts between scales of the same units, rounded to nearest, in a type wide enough for both.
+            template <typename To, typename From>
+            constexpr To rescale(const From& q) {
+                static_assert(is_same_v<typename To::units, typename From::units>, "The units must be the same");
+                using work = common_type_t<accumulator_t<typename From::value_type>, typename To::value_type>;
+                return static_cast<typename To::value_type>(ratio_convert<typename To::scale, typename From::scale,
+                    work, float_round_style::round_to_nearest>(static_cast<work>(q.count())));
+            }
+        }  // namespace detail
+
+        template <typename Quantity>
+        using sum_type = quantity<detail::accumulator_t<typename Quantity::value_type>, typename Quantity::units,
+            typename Quantity::scale>;
+
+        // The sum of [first, last) as a Dest, which must have the same units. Counts are summed per chunk in 64 bits,
+        // or double for floating point, and each partial sum is converted to Dest before they are added up. For an
+        // integer Dest coarser than the input this rounds once per chunk of 65536 readings.
+        template <typename Dest = void, typename Quantity>
+        auto reduce(const Quantity* first, const Quantity* last, thread_pool& pool = default_pool()) {
+            using value_type = typename Quantity::value_type;
+            static_assert(!numeric_limits<value_type>::is_integer || numeric_limits<value_type>::digits <= 32,
+                "64 bit counts could overflow the partial sums");
+            using dest = conditional_t<is_same_v<Dest, void>, sum_type<Quantity>, Dest>;
+            using acc = typename sum_type<Quantity>::value_type;
+            using partial = quantity<acc, typename Quantity::units, typename Quantity::scale>;
+
+#ifdef CTD_PARALLEL_STD_EXECUTION
+            (void)pool;
+            const acc total = std::transform_reduce(std::execution::par_unseq, first, last, acc(0), std::plus<>(),
+                [](const Quantity& q) { return static_cast<acc>(q.count()); });
+            return dest(detail::rescale<dest>(partial(total)));
+#else
+            const size_t n = size_t(last - first);
+            std::vector<typename dest::value_type> partials(detail::chunk_count(n));
+            pool.run(partials.size(), [&](size_t c) {
+                const Quantity* p = first + c * detail::chunk_size;
+                const Quantity* end = last - p < ptrdiff_t(detail::chunk_size) ? last : p + detail::chunk_size;
+                acc sum = 0;
+                for (; p != end; ++p) {
+                    sum += p->count();
+                }
+                partials[c] = detail::rescale<dest>(partial(sum)).count();
+            });
+            typename dest::value_type total = 0;
+            for (const auto& s : partials) {
+                total += s;
+            }
+            return dest(total);
+#endif
+        }
+
+        // Writes f(*it) for every element of [first, last) to out, converted to the scale of To and rounded to
+        // nearest. f returns a quantity with the units of To.
+        template <typename From, typename To, typename F>
+        void transform(const From* first, const From* last, To* out, F f, thread_pool& pool = default_pool()) {
+#ifdef CTD_PARALLEL_STD_EXECUTION
+            (void)pool;
+            std::transform(std::execution::par_unseq, first, last, out,
+                [&f](const From& q) { return To(detail::rescale<To>(f(q))); });
+#else
+            const size_t n = size_t(last - first);
+            pool.run(detail::chunk_count(n), [&](size_t c) {
+                const size_t begin = c * detail::chunk_size;
+                const size_t end = n - begin < detail::chunk_size ? n : begin + detail::chunk_size;
+                for (size_t i = begin; i < end; ++i) {
+                    out[i] = detail::rescale<To>(f(first[i]));
+                }
+            });
+#endif
+        }
+
+        // Converts [first, last) to the scale of To, rounded to nearest.
+        template <typename From, typename To>
+        void transform(const From* first, const From* last, To* out, thread_pool& pool = default_pool()) {
+            transform(first, last, out, [](const From& q) { return q; }, pool);
+        }
+
+        // The smallest and largest element of [first, last), which must not be empty.
+        template <typename Quantity>
+        std::pair<Quantity, Quantity> minmax(const Quantity* first, const Quantity* last,
+            thread_pool& pool = default_pool()) {
+            static_assert(Quantity::scale::num > 0, "Counts are compared directly");
+            using value_type = typename Quantity::value_type;
+
+#ifdef CTD_PARALLEL_STD_EXECUTION
+            (void)pool;
+            const auto [lo, hi] = std::minmax_element(std::execution::par_unseq, first, last,
+                [](const Quantity& a, const Quantity& b) { return a.count() < b.count(); });
+            return { *lo, *hi };
+#else
+            const size_t n = size_t(last - first);
+            std::vector<std::pair<value_type, value_type>> partials(detail::chunk_count(n));
+            pool.run(partials.size(), [&](size_t c) {
+                const Quantity* p = first + c * detail::chunk_size;
+                const Quantity* end = last - p < ptrdiff_t(detail::chunk_size) ? last : p + detail::chunk_size;
+                // Selects rather than branches, so the loop vectorizes.
+                value_type lo = p->count();
+                value_type hi = lo;
+                for (; p != end; ++p) {
+                    const value_type v = p->count();
+                    lo = v < lo ? v : lo;
+                    hi = hi < v ? v : hi;
+                }
+                partials[c] = { lo, hi };
+            });
+            value_type lo = partials[0].first;
+            value_type hi = partials[0].second;
+            for (const auto& [l, h] : partials) {
+                lo = l < lo ? l : lo;
+                hi = hi < h ? h : hi;
+            }
+            return { Quantity(lo), Quantity(hi) };
+#endif
+        }
+    }  // namespace parallel
+}  // namespace ctd
+
+#endif
@@ -0,0 +1,176 @@
+/*
+* This file provides a PID controller for a fixed update period, with quantity typed error and output. The gains and
+* the period are compile time ratios, so every unit and scale conversion folds into one multiply-shift constant per
+* term and an update has no divisions. The integrator keeps the fraction bits of the integral term, so error steps
+* smaller than one output LSB per period still accumulate, and it is clamped to the output limits for anti-windup.
+*/
+#ifndef CTD_PID_HPP
+#define CTD_PID_HPP
+
+#include <cstdint>
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // Multiplication by R of values of at most XDigits bits as (x * multiplier) >> shift. The multiplier has at
+        // most 31 bits and the product is below 2^61, so the sum of three terms fits in int64_t. The shift is at most
+        // MaxShift, which trades precision for headroom where the result is kept with its fraction bits.
+        template <typename R, int XDigits, int MaxShift = 62>
+        struct pid_gain {
+            constexpr static int bits = 61 - XDigits < 31 ? 61 - XDigits : 31;
+            constexpr static int shift = multiply_shift_bits<R, bits>() < MaxShift ? multiply_shift_bits<R, bits>()
+                                                                                  : MaxShift;
+            constexpr static int64_t multiplier = fixed_point_round(R::num, R::den, shift);
+            static_assert((multiplier < 0 ? -multiplier : multiplier) < (int64_t(1) << bits),
+                "The gain is too large for the error type");
+
+            // x * R with 'shift' fraction bits.
+            constexpr static int64_t scale(int64_t x) { return x * multiplier; }
+
+            // x * R rounded to nearest.
+            constexpr static int64_t apply(int64_t x) { return round(scale(x)); }
+
+            constexpr static int64_t round(int64_t v) {
+                if constexpr (shift == 0) {
+                    return v;
+                }
+                else {
+                    return (v + (int64_t(1) << (shift - 1))) >> shift;
+                }
+            }
+        };
+    }  // namespace detail
+
+    // A PID controller updated every Period seconds. The gains are ratios in the SI units of the error and output:
+    // Kp in output per error, Ki in output per error second, and Kd in output seconds per error. E.g. a current loop
+    // with a voltage output and Kp = 2 V/A has Kp = ratio<2>, whatever the scales of Error and Output are. Zero gains
+    // cost nothing.
+    template <typename Error, typename Output, typename Period, typename Kp, typename Ki, typename Kd = ratio<0>>
+    class pid_controller {
+        static_assert(is_quantity_v<Error> && is_quantity_v<Output>, "The error and output must be quantities");
+        static_assert(Period::num > 0, "The period must be positive");
+
+    public:
+        using error_type = Error;
+        using output_type = Output;
+
+        // The output is clamped to [min, max], and so is the integral term.
+        constexpr pid_controller(Output min, Output max) : lo(min.count()), hi(max.count()) {}
+
+        // Clears the derivative history and sets the integral term.
+        constexpr void reset(Output integral = Output(0)) {
+            if constexpr (is_integer) {
+                acc = clamp(int64_t(integral.count()) << i_gain::shift, lo_acc(), hi_acc());
+            }
+            else {
+                acc = integral.count();
+            }
+            started = false;
+        }
+
+        // Runs one period with the given error, setpoint minus measurement, and returns the new output.
+        constexpr Output update(Error error) {
+            const e_type e = error.count();
+            const diff_type de = started ? diff_type(diff_type(e) - prev) : diff_type(0);
+            prev = e;
+            started = true;
+
+            if constexpr (is_integer) {
+                const int64_t pd = term<p_coef, p_gain>(e) + term<d_coef, d_gain>(de);
+                const int64_t step = i_gain::scale(e);
+                int64_t next = clamp(acc + step, lo_acc(), hi_acc());
+                int64_t u = pd + i_gain::round(next);
+                // Conditional integration: while the output is saturated, the integrator may only unwind.
+                if ((u > hi && step > 0) || (u < lo && step < 0)) {
+                    next = acc;
+                    u = pd + i_gain::round(acc);
+                }
+                acc = next;
+                return static_cast<o_type>(clamp(u, lo, hi));
+            }
+            else {
+                const o_type pd = o_type(e) * factor<p_coef>() + o_type(de) * factor<d_coef>();
+                const o_type step = o_type(e) * factor<i_coef>();
+                o_type next = clamp(acc + step, o_type(lo), o_type(hi));
+                o_type u = pd + next;
+                if ((u > hi && step > 0) || (u < lo && step < 0)) {
+                    next = acc;
+                    u = pd + acc;
+                }
+                acc = next;
+                return clamp(u, o_type(lo), o_type(hi));
+            }
+        }
+
+        // The integral term.
+        constexpr Output integral() const {
+            if constexpr (is_integer) {
+                return static_cast<o_type>(i_gain::round(acc));
+            }
+            else {
+                return acc;
+            }
+        }
+
+    private:
+        using e_type = typename Error::value_type;
+        using o_type = typename Output::value_type;
+        constexpr static bool is_integer = numeric_limits<e_type>::is_integer && numeric_limits<o_type>::is_integer;
+        static_assert(is_integer || !numeric_limits<o_type>::is_integer,
+            "A floating point error needs a floating point output");
+
+        // Output counts per error count and period.
+        using to_output = ratio_divide<typename Error::scale, typename Output::scale>;
+        using p_coef = ratio_multiply<Kp, to_output>;
+        using i_coef = ratio_multiply<ratio_multiply<Ki, Period>, to_output>;
+        using d_coef = ratio_multiply<ratio_divide<Kd, Period>, to_output>;
+
+        constexpr static int e_digits = numeric_limits<e_type>::is_integer ? numeric_limits<e_type>::digits + 1 : 0;
+        constexpr static int o_digits = numeric_limits<o_type>::is_integer ? numeric_limits<o_type>::digits + 1 : 0;
+        static_assert(!is_integer || (e_digits <= 32 && o_digits <= 32), "At most 32 bit errors and outputs");
+        using p_gain = detail::pid_gain<p_coef, e_digits>;
+        using d_gain = detail::pid_gain<d_coef, e_digits + 1>;
+        // The integrator holds the output range with i_gain::shift fraction bits.
+        using i_gain = detail::pid_gain<i_coef, e_digits, 61 - o_digits>;
+
+        template <typename Coef, typename Gain>
+        constexpr static int64_t term(int64_t x) {
+            if constexpr (Coef::num == 0) {
+                return 0;
+            }
+            else {
+                return Gain::apply(x);
+            }
+        }
+
+        template <typename Coef>
+        constexpr static o_type factor() {
+            return o_type(Coef::num) / o_type(Coef::den);
+        }
+
+        template <typename T>
+        constexpr static T clamp(T v, T min, T max) {
+            return v < min ? min : v > max ? max : v;
+        }
+
+        constexpr int64_t lo_acc() const { return lo << i_gain::shift; }
+        constexpr int64_t hi_acc() const { return hi << i_gain::shift; }
+
+        // The error difference needs one more bit than the error.
+        using diff_type = conditional_t<is_integer, int64_t, e_type>;
+        using acc_type = conditional_t<is_integer, int64_t, o_type>;
+        using limit_type = conditional_t<is_integer, int64_t, o_type>;
+
+        limit_type lo;
+        limit_type hi;
+        acc_type acc = 0;
+        e_type prev = 0;
+        bool started = false;
+    };
+}  // namespace ctd
+
+#endif
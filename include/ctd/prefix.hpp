@@ -0,0 +1,96 @@
+/*
+* This file provides conversion of a quantity to one of a compile time list of scales picked at run time, e.g. when a
+* user interface lets the operator switch between mV, V and kV. Every conversion is instantiated at compile time and
+* dispatched through a table of function pointers, so each one is an exact integer conversion by constants, which the
+* compiler emits as a multiply and shift, with no floating point.
+*/
+#ifndef CTD_PREFIX_HPP
+#define CTD_PREFIX_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        // The SI prefix symbol of a scale, with u for micro, or nullptr for other scales.
+        template <typename Scale>
+        constexpr const char* prefix_symbol() {
+            using s = typename Scale::type;
+            const intmax_t num = s::num;
+            const intmax_t den = s::den;
+            const char* const small[] = { "", "m", "u", "n", "p", "f", "a" };
+            const char* const large[] = { "", "k", "M", "G", "T", "P", "E" };
+            intmax_t p = 1;
+            for (int i = 0; i < 7; ++i) {
+                if (num == 1 && den == p) {
+                    return small[i];
+                }
+                if (den == 1 && num == p) {
+                    return large[i];
+                }
+                p = i < 6 ? p * 1000 : p;
+            }
+            return num == 1 && den == 100 ? "c" : num == 1 && den == 10 ? "d" : num == 10 && den == 1 ? "da"
+                : num == 100 && den == 1 ? "h" : nullptr;
+        }
+    }  // namespace detail
+
+    // Converts quantities of type Q to the scale at a run time index into Scales, rounding to nearest. Integer
+    // results are intmax_t so that converting to a finer scale doesn't overflow the value type of Q.
+    template <typename Q, typename... Scales>
+    class prefix_converter {
+        static_assert(is_quantity_v<Q>, "prefix_converter requires a quantity");
+        static_assert(sizeof...(Scales) > 0, "At least one target scale is required");
+
+        using value_type = typename Q::value_type;
+
+    public:
+        using result_type = conditional_t<numeric_limits<value_type>::is_integer, intmax_t, value_type>;
+
+        constexpr static size_t size() { return sizeof...(Scales); }
+
+        // The count of q in the scale at 'index', which must be less than size().
+        static result_type convert(Q q, size_t index) { return table[index](q.count()); }
+
+        // The SI prefix symbol of the scale at 'index', e.g. "k" for kilo, or nullptr for a custom scale.
+        static const char* symbol(size_t index) { return symbols[index]; }
+
+        // The index of the largest scale in which q has a count of at least 1 in magnitude, or of the smallest scale
+        // if there is none. Scales must be in increasing order. For auto ranging displays.
+        static size_t autorange(Q q) {
+            size_t best = 0;
+            size_t i = 0;
+            ((best = at_least_one<Scales>(q.count()) ? i : best, ++i), ...);
+            return best;
+        }
+
+    private:
+        using function = result_type (*)(value_type);
+
+        template <typename Scale>
+        static result_type convert_to(value_type v) {
+            return ratio_convert<Scale, typename Q::scale, result_type, float_round_style::round_to_nearest>(v);
+        }
+
+        // Truncated, so that 999 uA stays 999 uA rather than becoming 1 mA.
+        template <typename Scale>
+        static bool at_least_one(value_type v) {
+            const result_type c = ratio_convert<Scale, typename Q::scale, result_type>(v);
+            return c >= 1 || c <= -1;
+        }
+
+        constexpr static function table[] = { &convert_to<Scales>... };
+        constexpr static const char* symbols[] = { detail::prefix_symbol<Scales>()... };
+    };
+
+    // Converts quantities of type Q to the SI prefixes from micro to mega, in that order.
+    template <typename Q>
+    using engineering_prefixes = prefix_converter<Q, micro, milli, ratio<1>, kilo, mega>;
+}  // namespace ctd
+
+#endif
@@ -13,13 +13,34 @@
 #include "ratio_impl.hpp"
 #endif
 
+#include "cmath.hpp"
 #include "limits.hpp"
 
+#ifdef CTD_INSTRUMENT
+#include "instrument.hpp"
+#include "type_traits.hpp"
+#endif
+
 namespace ctd {
+    namespace detail {
+        // Complex numbers, such as std::complex and fixed_complex, are scaled component wise.
+        template <typename T>
+        concept complex_like = requires(const T& t) {
+            typename T::value_type;
+            t.real();
+            t.imag();
+        };
+    }  // namespace detail
+
     // Computes x = y*r where r is a ratio<> object.
     template <typename R, typename T, float_round_style rounding = float_round_style::round_toward_zero>  // todo; enable only for r is ratio
     constexpr auto ratio_scale(T value) {
-        if (numeric_limits<T>::is_integer) {
+        if constexpr (detail::complex_like<T>) {
+            using V = typename T::value_type;
+            return T(static_cast<V>(ratio_scale<R, V, rounding>(value.real())),
+                static_cast<V>(ratio_scale<R, V, rounding>(value.imag())));
+        }
+        else if (numeric_limits<T>::is_integer) {
             // TODO: use a computation that doesn't overflow
             if (rounding == float_round_style::round_to_nearest) {
                 auto p = value * R::num;
@@ -46,9 +67,234 @@ namespace ctd {
     template <typename r_left, typename r_right, typename T, float_round_style rounding = float_round_style::round_toward_zero>
     constexpr T ratio_convert(T x) {
         using scale = ratio_divide<r_right, r_left>;
+#ifdef CTD_INSTRUMENT
+        const auto y = ratio_scale<scale, T, rounding>(x);
+        if constexpr (!detail::complex_like<T>) {
+            if (!is_constant_evaluated()) {
+                instrument::detail::record<r_right, r_left, T, scale>(x, y);
+            }
+        }
+        return y;
+#else
         return ratio_scale<scale, T, rounding>(x);
+#endif
     }
 
+    namespace detail {
+        constexpr intmax_t ipow(intmax_t base, int n) {
+            intmax_t ans = 1;
+            while (n-- > 0) {
+                ans *= base;
+            }
+            return ans;
+        }
+
+        constexpr intmax_t iroot(intmax_t v, int n) {
+            return n == 2 ? isqrt(v) : icbrt(v);
+        }
+
+        // Splits v > 0 into root^N * rest such that rest has no factor which is a perfect N-th power.
+        template <int N>
+        struct root_split {
+            intmax_t root = 1;
+            intmax_t rest = 1;
+
+            constexpr root_split(intmax_t v) {
+                // Scales are in practice products of small primes. Trial division is therefore limited to small
+                // primes to keep the compile time evaluation cheap, whatever is left is only checked for being a
+                // perfect N-th power. The split is always correct, it is just not minimal if the scale has a
+                // repeated prime factor larger than the limit together with other large factors.
+                for (intmax_t p = 2; p < 1000 && ipow(p, N + 1) <= v; ++p) {
+                    int k = 0;
+                    while (v % p == 0) {
+                        v /= p;
+                        ++k;
+                    }
+                    root *= ipow(p, k / N);
+                    rest *= ipow(p, k % N);
+                }
+
+                intmax_t r = iroot(v, N);
+                if (ipow(r, N) == v) {
+                    root *= r;
+                }
+                else {
+                    rest *= v;
+                }
+            }
+        };
+    }  // namespace detail
+
+    namespace detail {
+        // Computes round(num * 2^shift / den) for den > 0 by long division, so only the result has to fit in intmax_t.
+        constexpr intmax_t fixed_point_round(intmax_t num, intmax_t den, int shift) {
+            const uintmax_t d = uintmax_t(den);
+            const uintmax_t n = num < 0 ? uintmax_t(0) - uintmax_t(num) : uintmax_t(num);
+            uintmax_t q = n / d;
+            uintmax_t r = n % d;
+            for (int i = 0; i < shift; ++i) {
+                const bool bit = r >= d - r;
+                q = 2 * q + bit;
+                r = bit ? r - (d - r) : 2 * r;
+            }
+            q += r >= d - r;
+            return num < 0 ? -intmax_t(q) : intmax_t(q);
+        }
+
+        template <typename R, int Bits>
+        constexpr int multiply_shift_bits() {
+            int shift = 0;
+            while (shift < 62 && fixed_point_round(R::num < 0 ? -R::num : R::num, R::den, shift + 1) <
+                (intmax_t(1) << Bits)) {
+                ++shift;
+            }
+            return shift;
+        }
+    }  // namespace detail
+
+    // Multiplication by R as an integer multiply and a shift: x * R ~ (x * multiplier) >> shift. The multiplier is
+    // chosen as large as fits in Bits bits, which gives about Bits significant bits of precision. This is the fast
+    // path for constant scaling on cores without a hardware divider.
+    template <typename R, int Bits = 31>
+    struct ratio_multiply_shift {
+        static_assert(Bits > 0 && Bits < 63, "Bits must be in [1, 62]");
+
+        constexpr static int shift = detail::multiply_shift_bits<R, Bits>();
+        constexpr static intmax_t multiplier = detail::fixed_point_round(R::num, R::den, shift);
+
+        // Rounded to nearest. T must be able to hold x * multiplier.
+        template <typename T>
+        constexpr static T apply(T x) {
+            if constexpr (shift == 0) {
+                return static_cast<T>(x * multiplier);
+            }
+            else {
+                return static_cast<T>((x * T(multiplier) + (T(1) << (shift - 1))) >> shift);
+            }
+        }
+    };
+
+    // Computes R^N for N >= 0.
+    template <typename R, int N>
+    struct ratio_power {
+        static_assert(N >= 0, "Only non-negative powers are supported");
+        using type = ratio_multiply<R, typename ratio_power<R, N - 1>::type>;
+    };
+
+    template <typename R>
+    struct ratio_power<R, 0> {
+        using type = ratio<1>;
+    };
+
+    // Computes the N-th root (N = 2 or 3) of R, which is in general irrational. The root is split as
+    //   root(x * R) = root(x * radicand) * type
+    // where 'type' is a ratio and 'radicand' is the smallest integer needed to make the remainder exact.
+    template <typename R, int N>
+    struct ratio_root {
+        static_assert(N == 2 || N == 3, "Only square and cube roots are supported");
+        static_assert(N % 2 == 1 || R::num > 0, "Even roots require a positive ratio");
+
+    private:
+        constexpr static detail::root_split<N> num_split{R::num < 0 ? -R::num : R::num};
+        constexpr static detail::root_split<N> den_split{R::den};
+
+    public:
+        // With R = (a^N * rn) / (b^N * rd) we have: root(x * R) = root(x * rn * rd^(N-1)) * a / (b * rd).
+        constexpr static intmax_t radicand = num_split.rest * detail::ipow(den_split.rest, N - 1);
+        using type = typename ratio<sign(R::num) * num_split.root, den_split.root * den_split.rest>::type;
+    };
+
+    // Policies for ratio_approximate. approximation_shift picks the smallest power of two denominator, so that
+    // scaling is a multiply and a shift. approximation_simplest picks the fraction with the smallest numerator and
+    // denominator, so that both factors are small.
+    struct approximation_shift {};
+    struct approximation_simplest {};
+
+    namespace detail {
+        struct fraction {
+            intmax_t num;
+            intmax_t den;
+        };
+
+        // Compares a/b <= c/d for non-negative fractions by their continued fractions, so nothing can overflow.
+        constexpr bool fraction_less_equal(intmax_t a, intmax_t b, intmax_t c, intmax_t d) {
+            const intmax_t p = a / b;
+            const intmax_t q = c / d;
+            if (p != q) {
+                return p < q;
+            }
+            if (a % b == 0) {
+                return true;
+            }
+            if (c % d == 0) {
+                return false;
+            }
+            return fraction_less_equal(d, c % d, b, a % b);
+        }
+
+        // The fraction with the smallest denominator in [a/b, c/d], which is found by descending the Stern-Brocot
+        // tree one continued fraction term at a time.
+        constexpr fraction simplest_between(intmax_t a, intmax_t b, intmax_t c, intmax_t d) {
+            const intmax_t whole = a / b;
+            if (whole * b == a || (whole + 1) <= c / d) {
+                return { whole * b == a ? whole : whole + 1, 1 };
+            }
+            const fraction f = simplest_between(d, c - whole * d, b, a - whole * b);
+            return { whole * f.num + f.den, f.num };
+        }
+
+        template <typename Lo, typename Hi>
+        constexpr fraction approximate(approximation_simplest, intmax_t, intmax_t) {
+            return simplest_between(Lo::num, Lo::den, Hi::num, Hi::den);
+        }
+
+        template <typename Lo, typename Hi>
+        constexpr fraction approximate(approximation_shift, intmax_t num, intmax_t den) {
+            // The numerator is kept below 2^62.
+            for (int shift = 0; shift < 62 && num / den < (intmax_t(1) << (62 - shift)); ++shift) {
+                const intmax_t n = fixed_point_round(num, den, shift);
+                const intmax_t d = intmax_t(1) << shift;
+                if (fraction_less_equal(Lo::num, Lo::den, n, d) && fraction_less_equal(n, d, Hi::num, Hi::den)) {
+                    return { n, d };
+                }
+            }
+            return { 0, 0 };
+        }
+
+        constexpr int log2_floor(intmax_t v) {
+            int n = 0;
+            while (v > 1) {
+                v >>= 1;
+                ++n;
+            }
+            return n;
+        }
+    }  // namespace detail
+
+    // The best approximation of a positive ratio R within a relative error of MaxError, e.g. ratio<1, 1000> for
+    // 0.1%, chosen by Policy. The achieved relative error is available as the ratio 'error'.
+    template <typename R, typename MaxError, typename Policy = approximation_shift>
+    struct ratio_approximate {
+        static_assert(R::num > 0, "Only positive ratios can be approximated");
+        static_assert(MaxError::num >= 0 && MaxError::num < MaxError::den, "The error must be in [0, 1)");
+
+    private:
+        using lo = ratio_multiply<R, ratio_subtract<ratio<1>, MaxError>>;
+        using hi = ratio_multiply<R, ratio_add<ratio<1>, MaxError>>;
+        constexpr static detail::fraction result = detail::approximate<lo, hi>(Policy(), R::num, R::den);
+        static_assert(result.den != 0, "No approximation with a power of two denominator, allow a larger error");
+        using relative = ratio_subtract<ratio_divide<ratio<result.num, result.den>, R>, ratio<1>>;
+
+    public:
+        using type = typename ratio<result.num, result.den>::type;
+        constexpr static intmax_t num = type::num;
+        constexpr static intmax_t den = type::den;
+        // Scaling by type is (x * num) >> shift when den is a power of two.
+        constexpr static int shift = detail::log2_floor(den);
+        constexpr static bool power_of_two = (intmax_t(1) << shift) == den;
+        using error = ratio<(relative::num < 0 ? -relative::num : relative::num), relative::den>;
+    };
+
 }  // namespace ctd
 
 #endif
\ No newline at end of file
@@ -18,7 +18,7 @@ namespace ctd_impl {
 
     template <intmax_t NUM, intmax_t DEN = 1>
     struct ratio {
-        constexpr static intmax_t num = sign(DEN) * NUM / gcd(NUM, DEN);
+        constexpr static intmax_t num = ctd::sign(DEN) * NUM / gcd(NUM, DEN);
         constexpr static intmax_t den = abs(DEN) / gcd(NUM, DEN);
 
         constexpr static intmax_t value_round = (num + den / 2) / den;
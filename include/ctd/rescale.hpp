@@ -0,0 +1,125 @@
+/*
+* This file provides stateful rescaling of integer quantities for long chains of conversions and decimation loops. The
+* rounding modes of ratio_scale round every sample on its own, so a constant fraction of an LSB is lost on every
+* sample of a slowly varying signal, which biases its mean. The converters here remove that bias: error feedback
+* carries the remainder of each conversion into the next one, so the sum of the outputs is the sum of the inputs to
+* within one LSB, and stochastic rounding rounds up with a probability equal to the remainder, so each output is
+* unbiased on its own.
+*/
+#ifndef CTD_RESCALE_HPP
+#define CTD_RESCALE_HPP
+
+#include <cstdint>
+
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // Marsaglia's xorshift32 generator. A few cycles per number and good enough for dithering, but not for anything
+    // that needs statistical quality.
+    class xorshift32 {
+    public:
+        // The seed must be non zero.
+        constexpr explicit xorshift32(uint32_t seed = 2463534242u) : state(seed) {}
+
+        constexpr uint32_t operator()() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+    private:
+        uint32_t state;
+    };
+
+    namespace detail {
+        // The conversion factor from From to To, with the checks both converters share.
+        template <typename To, typename From>
+        struct rescale_traits {
+            static_assert(is_quantity_v<To> && is_quantity_v<From>, "Rescaling converts quantities");
+            static_assert(is_same_v<typename To::units, typename From::units>, "The units must be the same");
+            static_assert(numeric_limits<typename To::value_type>::is_integer &&
+                              numeric_limits<typename From::value_type>::is_integer,
+                "Rescaling with state is only needed for integer counts");
+
+            using factor = ratio_divide<typename From::scale, typename To::scale>;
+            // Counts and the factor are multiplied in int64_t, like ratio_scale does in intmax_t.
+            constexpr static intmax_t max_factor = numeric_limits<int32_t>::max();
+            static_assert(factor::num <= max_factor && factor::den <= max_factor, "The scale factor is too large");
+        };
+
+        // Floor division for den > 0.
+        constexpr int64_t floor_div(int64_t t, int64_t den, int64_t& rem) {
+            int64_t q = t / den;
+            rem = t - q * den;
+            if (rem < 0) {
+                rem += den;
+                --q;
+            }
+            return q;
+        }
+    }  // namespace detail
+
+    // Converts a stream of From quantities to To, carrying the remainder of each conversion into the next. The error
+    // of the sum of the outputs stays below one LSB of To however many samples there are, so the mean error goes to
+    // zero. The first output is rounded to nearest.
+    template <typename To, typename From>
+    class error_feedback_converter {
+        using traits = detail::rescale_traits<To, From>;
+        using factor = typename traits::factor;
+
+    public:
+        constexpr error_feedback_converter() = default;
+
+        constexpr To operator()(From q) {
+            if constexpr (factor::den == 1) {
+                return To(static_cast<typename To::value_type>(int64_t(q.count()) * factor::num));
+            }
+            else {
+                const int64_t t = int64_t(q.count()) * factor::num + remainder;
+                return To(static_cast<typename To::value_type>(detail::floor_div(t, factor::den, remainder)));
+            }
+        }
+
+        // Forgets the carried remainder, e.g. when a new series starts.
+        constexpr void reset() { remainder = factor::den / 2; }
+
+    private:
+        int64_t remainder = factor::den / 2;
+    };
+
+    // Converts From quantities to To, rounding each one up with a probability equal to the fraction that is lost by
+    // rounding down, so the expected value of every output is exact. Unlike error_feedback_converter the outputs
+    // don't depend on the order of the inputs, at the cost of a random error on each one. 'Random' is any generator
+    // of uniformly distributed uint32_t, e.g. xorshift32.
+    template <typename To, typename From, typename Random = xorshift32>
+    class stochastic_converter {
+        using traits = detail::rescale_traits<To, From>;
+        using factor = typename traits::factor;
+
+    public:
+        constexpr stochastic_converter() = default;
+        constexpr explicit stochastic_converter(Random random) : random(random) {}
+
+        constexpr To operator()(From q) {
+            if constexpr (factor::den == 1) {
+                return To(static_cast<typename To::value_type>(int64_t(q.count()) * factor::num));
+            }
+            else {
+                // A uniform number in [0, den) by a multiply and shift rather than a division.
+                const int64_t dither = int64_t((uint64_t(random()) * uint64_t(factor::den)) >> 32);
+                int64_t rem = 0;
+                const int64_t t = int64_t(q.count()) * factor::num + dither;
+                return To(static_cast<typename To::value_type>(detail::floor_div(t, factor::den, rem)));
+            }
+        }
+
+    private:
+        Random random;
+    };
+}  // namespace ctd
+
+#endif
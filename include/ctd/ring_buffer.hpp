@@ -0,0 +1,159 @@
+/*
+* This file provides a lock-free, fixed capacity ring buffer for one producer and one consumer, for example an
+* interrupt handler and the main loop, or two threads. Quantities are stored as their raw counts, the units and scale
+* are part of the element type.
+*/
+#ifndef CTD_RING_BUFFER_HPP
+#define CTD_RING_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "atomic.hpp"
+#include "type_traits.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    namespace detail {
+        template <typename T, bool = is_quantity_v<T>>
+        struct raw_element {
+            using type = T;
+            constexpr static const type& raw(const T& t) { return t; }
+            constexpr static const T& make(const type& r) { return r; }
+        };
+
+        template <typename T>
+        struct raw_element<T, true> {
+            using type = typename T::value_type;
+            constexpr static type raw(const T& q) { return q.count(); }
+            constexpr static T make(type r) { return T(r); }
+        };
+
+        // Separates the producer and consumer indices by a cache line on hosts to avoid false sharing. On
+        // microcontrollers there are no caches and RAM is precious.
+#ifdef HAS_STL
+        constexpr size_t ring_buffer_alignment = 64;
+#else
+        constexpr size_t ring_buffer_alignment = 1;
+#endif
+    }  // namespace detail
+
+    template <typename T, size_t Capacity>
+    class spsc_ring_buffer {
+        static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        using value_type = T;
+
+        // The indices run freely and wrap at twice the capacity or more, so the smallest type that can count to
+        // 2 * Capacity - 1 is used. This keeps the indices single byte, and thus natively atomic, on 8-bit cores.
+        using index_type = conditional_t<(Capacity <= 128), uint8_t,
+            conditional_t<(Capacity <= 32768), uint16_t,
+            conditional_t<(Capacity <= 0x80000000), uint32_t, uint64_t>>>;
+
+        constexpr static size_t capacity() { return Capacity; }
+
+        // Producer side: Adds one element. Returns false if the buffer is full.
+        bool push(const T& item) {
+            const index_type h = head.load(memory_order_relaxed);
+            if (!has_room(h)) {
+                return false;
+            }
+            buffer[h & mask] = element::raw(item);
+            head.store(static_cast<index_type>(h + 1), memory_order_release);
+            return true;
+        }
+
+        // Producer side: Adds up to n elements with a single index update. Returns the number added.
+        size_t push(const T* items, size_t n) {
+            const index_type h = head.load(memory_order_relaxed);
+            size_t room = Capacity - static_cast<index_type>(h - cached_tail);
+            if (room < n) {
+                cached_tail = tail.load(memory_order_acquire);
+                room = Capacity - static_cast<index_type>(h - cached_tail);
+            }
+            n = n < room ? n : room;
+
+            const size_t start = h & mask;
+            const size_t first = n < Capacity - start ? n : Capacity - start;
+            for (size_t i = 0; i < first; ++i) {
+                buffer[start + i] = element::raw(items[i]);
+            }
+            for (size_t i = first; i < n; ++i) {
+                buffer[i - first] = element::raw(items[i]);
+            }
+            head.store(static_cast<index_type>(h + n), memory_order_release);
+            return n;
+        }
+
+        // Consumer side: Removes one element into 'item'. Returns false if the buffer is empty.
+        bool pop(T& item) {
+            const index_type t = tail.load(memory_order_relaxed);
+            if (!has_data(t)) {
+                return false;
+            }
+            item = element::make(buffer[t & mask]);
+            tail.store(static_cast<index_type>(t + 1), memory_order_release);
+            return true;
+        }
+
+        // Consumer side: Removes up to n elements with a single index update. Returns the number removed.
+        size_t pop(T* items, size_t n) {
+            const index_type t = tail.load(memory_order_relaxed);
+            size_t available = static_cast<index_type>(cached_head - t);
+            if (available < n) {
+                cached_head = head.load(memory_order_acquire);
+                available = static_cast<index_type>(cached_head - t);
+            }
+            n = n < available ? n : available;
+
+            const size_t start = t & mask;
+            const size_t first = n < Capacity - start ? n : Capacity - start;
+            for (size_t i = 0; i < first; ++i) {
+                items[i] = element::make(buffer[start + i]);
+            }
+            for (size_t i = first; i < n; ++i) {
+                items[i] = element::make(buffer[i - first]);
+            }
+            tail.store(static_cast<index_type>(t + n), memory_order_release);
+            return n;
+        }
+
+        // The number of elements, exact only when called from the producer or consumer while the other is idle.
+        size_t size() const {
+            return static_cast<index_type>(head.load(memory_order_acquire) - tail.load(memory_order_acquire));
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+        using element = detail::raw_element<T>;
+        constexpr static index_type mask = static_cast<index_type>(Capacity - 1);
+
+        // The producer and consumer each keep a copy of the other side's index and only reload it, which costs a
+        // cache miss on hosts, when the copy says there is no room or no data.
+        bool has_room(index_type h) {
+            if (static_cast<index_type>(h - cached_tail) < Capacity) {
+                return true;
+            }
+            cached_tail = tail.load(memory_order_acquire);
+            return static_cast<index_type>(h - cached_tail) < Capacity;
+        }
+
+        bool has_data(index_type t) {
+            if (cached_head != t) {
+                return true;
+            }
+            cached_head = head.load(memory_order_acquire);
+            return cached_head != t;
+        }
+
+        alignas(detail::ring_buffer_alignment) atomic<index_type> head{ 0 };
+        index_type cached_tail = 0;
+        alignas(detail::ring_buffer_alignment) atomic<index_type> tail{ 0 };
+        index_type cached_head = 0;
+        alignas(detail::ring_buffer_alignment) typename element::type buffer[Capacity]{};
+    };
+}  // namespace ctd
+
+#endif
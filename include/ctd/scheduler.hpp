@@ -0,0 +1,136 @@
+/*
+* This file provides a cooperative scheduler for periodic tasks. Task periods are given as time<> quantities and are
+* converted into clock ticks at compile time. Deadlines are kept in a fixed size binary heap so dispatch is
+* O(log n) per task run and no memory is allocated.
+*/
+#ifndef CTD_SCHEDULER_HPP
+#define CTD_SCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "constant_evaluation.hpp"
+#include "limits.hpp"
+#include "ratio.hpp"
+#include "units.hpp"
+
+namespace ctd {
+    // Runs tasks periodically on a Clock such as tick_clock. Task is any callable taking no arguments.
+    template <typename Clock, size_t MaxTasks, typename Task = void (*)()>
+    class periodic_scheduler {
+    public:
+        using rep = typename Clock::rep;
+        using duration = typename Clock::duration;
+        using time_point = typename Clock::time_point;
+
+        // A task period in clock ticks. It can only be constructed from a constant time quantity, which is
+        // converted with ratio_convert during compilation. Periods that round to zero ticks or don't fit in half
+        // of the clock's counter range fail to compile.
+        class period {
+        public:
+            template <typename T, typename S>
+            consteval period(const time<T, S>& p)
+                : ticks(ratio_convert<typename Clock::period, S, intmax_t, float_round_style::round_to_nearest>(
+                    p.count())) {
+                if (ticks <= 0 || uintmax_t(ticks) > uintmax_t(numeric_limits<rep>::max() / 2)) {
+                    detail::fail_constant_evaluation();
+                }
+            }
+
+            constexpr duration count() const { return static_cast<rep>(ticks); }
+
+        private:
+            intmax_t ticks;
+        };
+
+        // Adds a task that first runs at 'start' + 'p'. Returns false if the scheduler is full.
+        constexpr bool add(period p, Task task, time_point start) {
+            if (size == MaxTasks) {
+                return false;
+            }
+            tasks[size] = { task, p.count(), start + p.count() };
+            heap[size] = static_cast<index_type>(size);
+            sift_up(size++);
+            return true;
+        }
+
+        bool add(period p, Task task) { return add(p, task, Clock::now()); }
+
+        // Runs every task that is due at 'now', each at most once. Periods that were missed entirely are skipped
+        // rather than run in a burst, the task keeps its phase. Returns the number of tasks that were run.
+        constexpr size_t dispatch(time_point now) {
+            size_t ran = 0;
+            while (size > 0 && Clock::reached(tasks[heap[0]].deadline, now)) {
+                entry& e = tasks[heap[0]];
+                do {
+                    e.deadline = e.deadline + e.interval;
+                } while (Clock::reached(e.deadline, now));
+                sift_down(0);
+                e.task();
+                ++ran;
+            }
+            return ran;
+        }
+
+        size_t dispatch() { return dispatch(Clock::now()); }
+
+        // The earliest deadline of all tasks. The scheduler must not be empty.
+        constexpr time_point next_deadline() const { return tasks[heap[0]].deadline; }
+
+        constexpr size_t task_count() const { return size; }
+
+    private:
+        using index_type = conditional_t<(MaxTasks <= 256), uint8_t, size_t>;
+
+        struct entry {
+            Task task;
+            duration interval;
+            time_point deadline;
+        };
+
+        constexpr bool before(index_type a, index_type b) const {
+            return !Clock::reached(tasks[b].deadline, tasks[a].deadline) ||
+                (tasks[a].deadline == tasks[b].deadline && a < b);
+        }
+
+        constexpr void sift_up(size_t i) {
+            while (i > 0) {
+                size_t parent = (i - 1) / 2;
+                if (!before(heap[i], heap[parent])) {
+                    break;
+                }
+                index_type tmp = heap[i];
+                heap[i] = heap[parent];
+                heap[parent] = tmp;
+                i = parent;
+            }
+        }
+
+        constexpr void sift_down(size_t i) {
+            for (;;) {
+                size_t first = i;
+                size_t left = 2 * i + 1;
+                size_t right = left + 1;
+                if (left < size && before(heap[left], heap[first])) {
+                    first = left;
+                }
+                if (right < size && before(heap[right], heap[first])) {
+                    first = right;
+                }
+                if (first == i) {
+                    return;
+                }
+                index_type tmp = heap[i];
+                heap[i] = heap[first];
+                heap[first] = tmp;
+                i = first;
+            }
+        }
+
+        entry tasks[MaxTasks]{};
+        index_type heap[MaxTasks]{};
+        size_t size = 0;
+    };
+}  // namespace ctd
+
+#endif
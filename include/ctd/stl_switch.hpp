@@ -1,11 +1,16 @@
 #ifndef CTD_STL_SWITCH_HPP
 #define CTD_STL_SWITCH_HPP
 
+#ifndef HAS_STL
+// Declared here so that the using directive below doesn't depend on the order of the includes.
+namespace ctd_impl {}
+#endif // HAS_STL
+
 namespace ctd {
 #ifdef HAS_STL
     using namespace std;
 #else
-    using namespace ctd_impl;
+    using namespace ::ctd_impl;
 #endif // HAS_STL
 }
 
@@ -417,6 +417,13 @@ namespace ctd_impl {
     template <typename T>
     struct is_signed : detail::is_signed<T>::type {};
 
+    // ---------------------------------------------------------------------------
+    // is_constant_evaluated
+    // ---------------------------------------------------------------------------
+    constexpr bool is_constant_evaluated() noexcept {
+        return __builtin_is_constant_evaluated();
+    }
+
 }  // namespace ctd_impl
 
 #endif // !CTD_TYPE_TRAITS_IMPL_HPP
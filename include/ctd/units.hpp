@@ -4,9 +4,12 @@
 #include <cstdint>
 
 #ifdef HAS_STL
+#include <chrono>
+#include <cmath>
 #include <ostream>
 #endif
 
+#include "cmath.hpp"
 #include "ratio.hpp"
 #include "numeric.hpp"
 #include "units_impl.hpp"
@@ -73,6 +76,23 @@ namespace ctd {
             : v(ratio_convert<scale, OtherScale, ValueType, rounding>(q.count())) {
         }
 
+#ifdef HAS_STL
+        // Time quantities convert implicitly to and from std::chrono::duration with a single ratio_convert, computed
+        // in the common type of both representations.
+        template <typename Rep, typename Period>
+            requires is_same_v<Units, ctd::units::second>
+        constexpr quantity(const std::chrono::duration<Rep, Period>& d)
+            : v(static_cast<ValueType>(ratio_convert<scale, Period, common_type_t<Rep, ValueType>>(d.count()))) {
+        }
+
+        template <typename Rep, typename Period>
+            requires is_same_v<Units, ctd::units::second>
+        constexpr operator std::chrono::duration<Rep, Period>() const {
+            using common = common_type_t<Rep, ValueType>;
+            return std::chrono::duration<Rep, Period>(static_cast<Rep>(ratio_convert<Period, scale, common>(v)));
+        }
+#endif
+
         constexpr quantity& operator=(const quantity&) = default;
 
         constexpr quantity operator-() const { return quantity(-count()); }
@@ -105,6 +125,15 @@ namespace ctd {
         value_type v;
     };
 
+    template <typename T>
+    struct is_quantity : false_type {};
+
+    template <typename ValueType, typename Units, typename Scale>
+    struct is_quantity<quantity<ValueType, Units, Scale>> : true_type {};
+
+    template <typename T>
+    constexpr bool is_quantity_v = is_quantity<T>::value;
+
     //
     // Convenience type aliases for the seven base units
     // 
@@ -153,6 +182,26 @@ namespace ctd {
     template <typename type, typename scale = ratio<1>>
     using speed = quantity<type, units::speed, scale>;
 
+    namespace detail {
+        // Multiplies a count by an integer scale factor. Floating point complex counts only multiply by their own
+        // component type.
+        template <typename T>
+        constexpr auto scale_count(const T& v, intmax_t k) {
+            if constexpr (ctd::detail::complex_like<T>) {
+                using V = typename T::value_type;
+                if constexpr (!numeric_limits<V>::is_integer) {
+                    return v * static_cast<V>(k);
+                }
+                else {
+                    return v * k;
+                }
+            }
+            else {
+                return v * k;
+            }
+        }
+    }  // namespace detail
+
     //
     // Basic operators
     //
@@ -198,11 +247,11 @@ namespace ctd {
         // Scale = g_s * gcd(a_p, c_p) * gcd(d_p, b_p) / (b*d)
         //       = g_s * gcd(a_p, c_p) * gcd(d_p, b_p) / (b_p*d_p*g_ad*g_bc)
 
-        using scale = ratio_multiply<ratio_multiply<ratio<gcd(d_p, b_p), max(b_p, d_p)>::type,
-            ratio<gcd(a_p, c_p), min(b_p, d_p)>::type>,
-            ratio<g_s, g_ad* g_bc>::type>;
+        using scale = ratio_multiply<ratio_multiply<typename ratio<gcd(d_p, b_p), max(b_p, d_p)>::type,
+            typename ratio<gcd(a_p, c_p), min(b_p, d_p)>::type>,
+            typename ratio<g_s, g_ad* g_bc>::type>;
 
-        auto ans = lhs.count() * scale_left + rhs.count() * scale_right;
+        auto ans = detail::scale_count(lhs.count(), scale_left) + detail::scale_count(rhs.count(), scale_right);
         return quantity<decltype(ans), units, scale>(ans);
     }
 
@@ -255,7 +304,8 @@ namespace ctd {
     template <typename val_l, typename val_r, typename units, typename scales_l, typename scales_r>
     constexpr auto operator==(const quantity<val_l, units, scales_l>& lhs,
         const quantity<val_r, units, scales_r>& rhs) {
-        return 0 == (lhs - rhs).count();
+        const auto diff = (lhs - rhs).count();
+        return diff == decltype(diff)(0);
     }
 
     template <typename val_l, typename val_r, typename units, typename scales_l, typename scales_r>
@@ -301,6 +351,120 @@ namespace ctd {
         return !(lhs == rhs);
     }
 
+    //
+    // Powers and roots
+    //
+#ifdef HAS_STL
+    using std::pow;
+    using std::sqrt;
+    using std::cbrt;
+#endif
+
+    // Raises a quantity to the N-th power, N >= 0. The unit exponents and the scale are raised at compile time.
+    template <int N, typename ValueType, typename Units, typename Scale>
+    constexpr auto pow(const quantity<ValueType, Units, Scale>& q) {
+        using value_type = decltype(q.count() * q.count());
+        value_type ans = 1;
+        value_type base = q.count();
+        for (int n = N; n > 0; n >>= 1) {
+            if (n & 1) {
+                ans *= base;
+            }
+            base *= base;
+        }
+        return quantity<value_type, units::detail::unit_powers_multiply<Units, N>,
+            typename ratio_power<Scale, N>::type>(ans);
+    }
+
+    namespace detail {
+        template <int N, typename T>
+        constexpr T root_newton(T x) {
+            if (x == 0) {
+                return x;
+            }
+            T y = x < 0 ? -x : x;
+            T r = y > 1 ? y : 1;
+            for (int i = 0; i < 64; ++i) {
+                T next = ((N - 1) * r + y / (N == 2 ? r : r * r)) / N;
+                if (next == r) {
+                    break;
+                }
+                r = next;
+            }
+            return x < 0 ? -r : r;
+        }
+
+        // Computes the count of root(q) where q has the given count and scale. Integers use the bit-by-bit kernels
+        // and are only widened if the scale isn't a perfect power.
+        template <int N, typename Scale, typename T>
+        constexpr T root_count(T count) {
+            using root = ratio_root<Scale, N>;
+            if constexpr (numeric_limits<T>::is_integer) {
+                if constexpr (root::radicand == 1) {
+                    return N == 2 ? isqrt(count) : icbrt(count);
+                }
+                else {
+                    intmax_t x = count * root::radicand;
+                    return static_cast<T>(N == 2 ? isqrt(x) : icbrt(x));
+                }
+            }
+            else {
+                T x = count * static_cast<T>(root::radicand);
+#ifdef HAS_STL
+                if (!is_constant_evaluated()) {
+                    return N == 2 ? std::sqrt(x) : std::cbrt(x);
+                }
+#endif
+                return root_newton<N>(x);
+            }
+        }
+    }  // namespace detail
+
+    // Computes the square root of a quantity, e.g. sqrt(area) is a length. It is a compile error to take the root of
+    // a unit with an odd exponent. The scale is split into a perfect square and a remainder which is multiplied into
+    // the count, so for example sqrt of a quantity in mm^2 is exact while sqrt of a quantity in mm is computed from
+    // count * 10 with the result in units of 1/100.
+    template <typename ValueType, typename Units, typename Scale>
+    constexpr auto sqrt(const quantity<ValueType, Units, Scale>& q) {
+        return quantity<ValueType, units::detail::unit_powers_divide<Units, 2>,
+            typename ratio_root<Scale, 2>::type>(detail::root_count<2, Scale>(q.count()));
+    }
+
+    // Computes the cube root of a quantity, see sqrt.
+    template <typename ValueType, typename Units, typename Scale>
+    constexpr auto cbrt(const quantity<ValueType, Units, Scale>& q) {
+        return quantity<ValueType, units::detail::unit_powers_divide<Units, 3>,
+            typename ratio_root<Scale, 3>::type>(detail::root_count<3, Scale>(q.count()));
+    }
+
+    // Converts q to To with the scale factor replaced by ratio_approximate<factor, MaxError, Policy>. This trades a
+    // relative error of at most MaxError for a cheaper conversion, with approximation_shift a multiply and a shift
+    // instead of a multiply and a divide. Integer results are rounded to nearest.
+    template <typename To, typename MaxError, typename Policy = approximation_shift, typename ValueType,
+        typename Units, typename Scale>
+    constexpr To approximate_cast(const quantity<ValueType, Units, Scale>& q) {
+        static_assert(is_same_v<Units, typename To::units>, "The units must be the same");
+        using factor = ratio_approximate<ratio_divide<Scale, typename To::scale>, MaxError, Policy>;
+        using T = typename To::value_type;
+        if constexpr (numeric_limits<ValueType>::is_integer && numeric_limits<T>::is_integer) {
+            const intmax_t p = intmax_t(q.count()) * factor::num;
+            if constexpr (!factor::power_of_two) {
+                return static_cast<T>(ratio_scale<ratio<1, factor::den>, intmax_t,
+                    float_round_style::round_to_nearest>(p));
+            }
+            else if constexpr (factor::shift == 0) {
+                return static_cast<T>(p);
+            }
+            else {
+                return static_cast<T>((p + (intmax_t(1) << (factor::shift - 1))) >> factor::shift);
+            }
+        }
+        else {
+            using F = conditional_t<numeric_limits<T>::is_integer, ValueType, T>;
+            return static_cast<T>(static_cast<F>(q.count()) * (F(factor::num) / F(factor::den)));
+        }
+    }
+
 #ifdef HAS_STL
     template <typename Val, typename Units, typename Scales>
     std::ostream& operator<<(std::ostream& os, const quantity<Val, Units, Scales>& q) {
@@ -325,82 +489,144 @@ namespace ctd {
     }
 
 
-    namespace unit_literals {
-
-#define MAKE_LITERAL(LIT, UNIT, TYPE, SCALE)                   \
-  constexpr auto operator"" _##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, SCALE>;           \
-    return type(static_cast<type::value_type>(x));             \
-  }
-
-#define MAKE_LITERAL_PREFIXES(LIT, UNIT, TYPE)                  \
-  constexpr auto operator"" _f##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, femto>;             \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _p##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, pico>;             \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _n##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, nano>;             \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _u##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, micro>;            \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _m##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, milli>;            \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _##LIT(unsigned long long int x) {  \
-    using type = quantity<TYPE, UNIT, ratio<1>>;         \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _k##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, kilo>;             \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _M##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, mega>;             \
-    return type(static_cast<type::value_type>(x));              \
-  }                                                             \
-  constexpr auto operator"" _G##LIT(unsigned long long int x) { \
-    using type = quantity<TYPE, UNIT, giga>;             \
-    return type(static_cast<type::value_type>(x));              \
-  }
-
-        MAKE_LITERAL(ppm, units::unity, long, micro)
-            MAKE_LITERAL(ppt, units::unity, long, milli)
-
-            MAKE_LITERAL(g, units::kilogram, long, milli)
-            MAKE_LITERAL(kg, units::kilogram, long, ratio<1>)
-            MAKE_LITERAL(ton, units::kilogram, long, kilo)
+    // Unit literals such as 5_mV are quantities of long by default. Define CTD_LITERAL_VALUE_TYPE to use another
+    // type for all literals, e.g. int to keep literal arithmetic in the native word size, or define
+    // CTD_LITERAL_SMALLEST_TYPE to give each literal the smallest signed integer type that holds it. Either way a
+    // literal that doesn't fit its type is a compile error.
+    namespace detail {
+        consteval int literal_digit(char c) {
+            if (c >= '0' && c <= '9') {
+                return c - '0';
+            }
+            if (c >= 'a' && c <= 'f') {
+                return c - 'a' + 10;
+            }
+            if (c >= 'A' && c <= 'F') {
+                return c - 'A' + 10;
+            }
+            return 99;
+        }
 
-            MAKE_LITERAL(km_h, units::speed, long, ratio<1>)
-            MAKE_LITERAL(m_s2, units::acceleration, long, ratio<1>)
+        struct parsed_literal {
+            unsigned long long value;
+            bool is_integer;
+            bool too_large;
+        };
+
+        // The value of an integer literal from its characters, in any base and with digit separators.
+        template <char... Chars>
+        consteval parsed_literal parse_literal() {
+            constexpr char chars[] = { Chars... };
+            constexpr size_t n = sizeof...(Chars);
+            unsigned long long base = 10;
+            size_t i = 0;
+            if (n > 1 && chars[0] == '0') {
+                if (chars[1] == 'x' || chars[1] == 'X') {
+                    base = 16;
+                    i = 2;
+                }
+                else if (chars[1] == 'b' || chars[1] == 'B') {
+                    base = 2;
+                    i = 2;
+                }
+                else {
+                    base = 8;
+                    i = 1;
+                }
+            }
+            parsed_literal ans = { 0, true, false };
+            for (; i < n; ++i) {
+                if (chars[i] == '\'') {
+                    continue;
+                }
+                const int digit = literal_digit(chars[i]);
+                if (unsigned(digit) >= base) {
+                    ans.is_integer = false;
+                    return ans;
+                }
+                if (ans.value > (numeric_limits<unsigned long long>::max() - unsigned(digit)) / base) {
+                    ans.too_large = true;
+                    return ans;
+                }
+                ans.value = ans.value * base + unsigned(digit);
+            }
+            return ans;
+        }
 
-            MAKE_LITERAL_PREFIXES(s, units::second, long)
-            MAKE_LITERAL(min, units::second, long, ratio<60L>)
-            MAKE_LITERAL(h, units::second, long, ratio<60L * 60L>)
-            MAKE_LITERAL(days, units::second, long, ratio<60L * 60L * 24L>)
+        template <unsigned long long Value>
+        struct literal_value {
+#if defined(CTD_LITERAL_SMALLEST_TYPE)
+            using type = conditional_t<(Value <= INT8_MAX), int8_t, conditional_t<(Value <= INT16_MAX), int16_t,
+                conditional_t<(Value <= INT32_MAX), int32_t, int64_t>>>;
+#elif defined(CTD_LITERAL_VALUE_TYPE)
+            using type = CTD_LITERAL_VALUE_TYPE;
+#else
+            using type = long;
+#endif
+        };
+
+        template <typename Units, typename Scale, char... Chars>
+        consteval auto make_literal() {
+            constexpr parsed_literal parsed = parse_literal<Chars...>();
+            static_assert(parsed.is_integer, "Unit literals must be integers");
+            static_assert(!parsed.too_large, "The literal doesn't fit in unsigned long long");
+            constexpr unsigned long long value = parsed.value;
+            using type = typename literal_value<value>::type;
+            static_assert(value <= static_cast<unsigned long long>(numeric_limits<type>::max()),
+                "The literal doesn't fit in the literal value type");
+            return quantity<type, Units, Scale>(static_cast<type>(value));
+        }
+    }  // namespace detail
 
-            MAKE_LITERAL_PREFIXES(K, units::kelvin, long)
+    namespace unit_literals {
 
-            MAKE_LITERAL_PREFIXES(m, units::metre, long)
-            MAKE_LITERAL_PREFIXES(N, units::newton, long)
-            MAKE_LITERAL_PREFIXES(Pa, units::pascal, long)
-            MAKE_LITERAL_PREFIXES(J, units::joule, long)
-            MAKE_LITERAL_PREFIXES(W, units::watt, long)
+#define MAKE_LITERAL(LIT, UNIT, SCALE)                                  \
+  template <char... Chars>                                              \
+  consteval auto operator"" _##LIT() {                                  \
+    return detail::make_literal<UNIT, SCALE, Chars...>();               \
+  }
 
-            MAKE_LITERAL_PREFIXES(Hz, units::hertz, long)
-            MAKE_LITERAL_PREFIXES(A, units::ampere, long)
-            MAKE_LITERAL_PREFIXES(V, units::volt, long)
-            MAKE_LITERAL_PREFIXES(Ohm, units::ohm, long)
-            MAKE_LITERAL_PREFIXES(F, units::farad, long)
-            MAKE_LITERAL_PREFIXES(H, units::henry, long)
-            MAKE_LITERAL_PREFIXES(C, units::coulomb, long)
+#define MAKE_LITERAL_PREFIXES(LIT, UNIT) \
+  MAKE_LITERAL(f##LIT, UNIT, femto)      \
+  MAKE_LITERAL(p##LIT, UNIT, pico)       \
+  MAKE_LITERAL(n##LIT, UNIT, nano)       \
+  MAKE_LITERAL(u##LIT, UNIT, micro)      \
+  MAKE_LITERAL(m##LIT, UNIT, milli)      \
+  MAKE_LITERAL(LIT, UNIT, ratio<1>)      \
+  MAKE_LITERAL(k##LIT, UNIT, kilo)       \
+  MAKE_LITERAL(M##LIT, UNIT, mega)       \
+  MAKE_LITERAL(G##LIT, UNIT, giga)
+
+        MAKE_LITERAL(ppm, units::unity, micro)
+            MAKE_LITERAL(ppt, units::unity, milli)
+
+            MAKE_LITERAL(g, units::kilogram, milli)
+            MAKE_LITERAL(kg, units::kilogram, ratio<1>)
+            MAKE_LITERAL(ton, units::kilogram, kilo)
+
+            MAKE_LITERAL(km_h, units::speed, ratio<1>)
+            MAKE_LITERAL(m_s2, units::acceleration, ratio<1>)
+
+            MAKE_LITERAL_PREFIXES(s, units::second)
+            MAKE_LITERAL(min, units::second, ratio<60L>)
+            MAKE_LITERAL(h, units::second, ratio<60L * 60L>)
+            MAKE_LITERAL(days, units::second, ratio<60L * 60L * 24L>)
+
+            MAKE_LITERAL_PREFIXES(K, units::kelvin)
+
+            MAKE_LITERAL_PREFIXES(m, units::metre)
+            MAKE_LITERAL_PREFIXES(N, units::newton)
+            MAKE_LITERAL_PREFIXES(Pa, units::pascal)
+            MAKE_LITERAL_PREFIXES(J, units::joule)
+            MAKE_LITERAL_PREFIXES(W, units::watt)
+
+            MAKE_LITERAL_PREFIXES(Hz, units::hertz)
+            MAKE_LITERAL_PREFIXES(A, units::ampere)
+            MAKE_LITERAL_PREFIXES(V, units::volt)
+            MAKE_LITERAL_PREFIXES(Ohm, units::ohm)
+            MAKE_LITERAL_PREFIXES(F, units::farad)
+            MAKE_LITERAL_PREFIXES(H, units::henry)
+            MAKE_LITERAL_PREFIXES(C, units::coulomb)
 
 #undef MAKE_LITERAL
 #undef MAKE_LITERAL_PREFIXES
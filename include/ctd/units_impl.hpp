@@ -46,6 +46,36 @@ namespace ctd {
                 lhs::candela - rhs::candela,
                 lhs::mole - rhs::mole>;
 
+            template <typename units, int N>
+            using unit_powers_multiply = unit_powers<
+                units::ampere * N,
+                units::kelvin * N,
+                units::second * N,
+                units::metre * N,
+                units::kilogram * N,
+                units::candela * N,
+                units::mole * N>;
+
+            // The N-th root of a unit, which only exists if every exponent is divisible by N.
+            template <typename units, int N>
+            struct unit_powers_root {
+                static_assert(units::ampere % N == 0 && units::kelvin % N == 0 && units::second % N == 0 &&
+                    units::metre % N == 0 && units::kilogram % N == 0 && units::candela % N == 0 &&
+                    units::mole % N == 0, "The unit has an exponent that isn't divisible by the root");
+
+                using type = unit_powers<
+                    units::ampere / N,
+                    units::kelvin / N,
+                    units::second / N,
+                    units::metre / N,
+                    units::kilogram / N,
+                    units::candela / N,
+                    units::mole / N>;
+            };
+
+            template <typename units, int N>
+            using unit_powers_divide = typename unit_powers_root<units, N>::type;
+
 #ifdef HAS_STL
             template <int A, int K, int s, int m, int kg, int cd, int mol>
             std::ostream& operator<<(std::ostream& os, const unit_powers<A, K, s, m, kg, cd, mol>& o) {
@@ -0,0 +1,132 @@
+/*
+* The ctd module interface. It exports the same names as the headers, so 'import ctd;' can replace including them.
+* HAS_STL and the other configuration macros must be defined the same way for the module as for its importers, the
+* CMake option CTD_MODULE builds it as the ctd_module library when the generator supports modules.
+*
+* The headers are included inside an export block rather than re-declared with using declarations, since compilers
+* don't make names from the global module fragment visible to importers through an exported using declaration. The
+* standard headers they use are included in the global module fragment first, so their include guards keep them out
+* of the module purview.
+*/
+module;
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef HAS_STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <ostream>
+#include <ratio>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef CTD_PARALLEL_STD_EXECUTION
+#include <execution>
+#include <functional>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#else
+#include "cstdint.hpp"
+#ifdef __AVR__
+#include <util/atomic.h>
+#endif
+#endif // HAS_STL
+
+#include "ctd/stl_switch.hpp"
+
+export module ctd;
+
+export {
+#include "ctd/algorithm.hpp"
+#include "ctd/angle.hpp"
+#include "ctd/atomic_quantity.hpp"
+#include "ctd/bounded.hpp"
+#include "ctd/calibration.hpp"
+#include "ctd/clock.hpp"
+#include "ctd/column_codec.hpp"
+#include "ctd/complex.hpp"
+#include "ctd/cmath.hpp"
+#include "ctd/fft.hpp"
+#include "ctd/filters.hpp"
+#include "ctd/linalg.hpp"
+#include "ctd/packed_quantity_array.hpp"
+#include "ctd/lookup.hpp"
+#include "ctd/mmio.hpp"
+#include "ctd/pid.hpp"
+#include "ctd/prefix.hpp"
+#include "ctd/ratio.hpp"
+#include "ctd/rescale.hpp"
+#include "ctd/ring_buffer.hpp"
+#include "ctd/scheduler.hpp"
+#include "ctd/units.hpp"
+
+#ifdef HAS_STL
+#include "ctd/instrument.hpp"
+#include "ctd/parallel.hpp"
+#endif
+}
+
+// The headers find the names of <ratio> through the using directive in stl_switch.hpp, which can't be exported, so
+// importers get aliases of them instead.
+#ifdef HAS_STL
+#define CTD_STD std
+#else
+#define CTD_STD ctd_impl
+#endif
+
+export namespace ctd {
+    template <intmax_t NUM, intmax_t DEN = 1>
+    using ratio = CTD_STD::ratio<NUM, DEN>;
+    template <typename R1, typename R2>
+    using ratio_add = CTD_STD::ratio_add<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_subtract = CTD_STD::ratio_subtract<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_multiply = CTD_STD::ratio_multiply<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_divide = CTD_STD::ratio_divide<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_equal = CTD_STD::ratio_equal<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_less = CTD_STD::ratio_less<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_less_equal = CTD_STD::ratio_less_equal<R1, R2>;
+#ifdef HAS_STL
+    template <typename R1, typename R2>
+    using ratio_not_equal = std::ratio_not_equal<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_greater = std::ratio_greater<R1, R2>;
+    template <typename R1, typename R2>
+    using ratio_greater_equal = std::ratio_greater_equal<R1, R2>;
+#endif
+    using femto = CTD_STD::femto;
+    using pico = CTD_STD::pico;
+    using nano = CTD_STD::nano;
+    using micro = CTD_STD::micro;
+    using milli = CTD_STD::milli;
+    using centi = CTD_STD::centi;
+    using deci = CTD_STD::deci;
+    using deca = CTD_STD::deca;
+    using hecto = CTD_STD::hecto;
+    using kilo = CTD_STD::kilo;
+    using mega = CTD_STD::mega;
+    using giga = CTD_STD::giga;
+}  // namespace ctd
+
+#undef CTD_STD
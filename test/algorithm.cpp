@@ -0,0 +1,152 @@
+#include "ctd/algorithm.hpp"
+#include "ctd/algorithm_impl.hpp"
+#include "ctd/units.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        using namespace ctd::unit_literals;
+
+        // By the 0-1 principle a comparator network sorts every input if it sorts every sequence of zeros and ones.
+        template <size_t N>
+        void expect_sorts_all_binary_inputs() {
+            for (uint32_t bits = 0; bits < (uint32_t(1) << N); ++bits) {
+                int data[N > 0 ? N : 1] = {};
+                for (size_t i = 0; i < N; ++i) {
+                    data[i] = (bits >> i) & 1;
+                }
+                static_sort<N>(&data[0]);
+                EXPECT_TRUE(std::is_sorted(data, data + N)) << "N = " << N << ", input = " << bits;
+            }
+        }
+
+        TEST(StaticSort, SortsAllBinaryInputs) {
+            expect_sorts_all_binary_inputs<0>();
+            expect_sorts_all_binary_inputs<1>();
+            expect_sorts_all_binary_inputs<2>();
+            expect_sorts_all_binary_inputs<3>();
+            expect_sorts_all_binary_inputs<5>();
+            expect_sorts_all_binary_inputs<7>();
+            expect_sorts_all_binary_inputs<8>();
+            expect_sorts_all_binary_inputs<9>();
+            expect_sorts_all_binary_inputs<13>();
+            expect_sorts_all_binary_inputs<16>();
+        }
+
+        TEST(StaticSort, ComparatorCount) {
+            // Known sizes of Batcher's networks.
+            static_assert(detail::sorting_network<4>::count() == 5, "");
+            static_assert(detail::sorting_network<8>::count() == 19, "");
+            static_assert(detail::sorting_network<16>::count() == 63, "");
+        }
+
+        TEST(StaticSort, Constexpr) {
+            constexpr auto sorted = [] {
+                struct { int v[5]; } a = { { 4, 1, 5, 2, 3 } };
+                static_sort(a.v);
+                return a;
+            }();
+            static_assert(sorted.v[0] == 1 && sorted.v[2] == 3 && sorted.v[4] == 5, "");
+        }
+
+        TEST(Median, Quantities) {
+            const voltage<int16_t, milli> v[5] = { 30_mV, -10_mV, 200_mV, 20_mV, 25_mV };
+            EXPECT_EQ(25_mV, median(v));
+
+            const voltage<int16_t, milli> w[7] = { 1_mV, 7_mV, 3_mV, 6_mV, 2_mV, 5_mV, 4_mV };
+            EXPECT_EQ(4_mV, median(w));
+
+            constexpr int x[9] = { 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+            static_assert(median(x) == 5, "");
+        }
+
+        TEST(Median, EvenCountTakesUpperMiddle) {
+            const int x[4] = { 4, 1, 3, 2 };
+            EXPECT_EQ(3, median(x));
+        }
+
+        TEST(AlgorithmImpl, MinMaxClamp) {
+            static_assert(ctd_impl::min(3, 2) == 2, "");
+            static_assert(ctd_impl::max(3, 2) == 3, "");
+            static_assert(ctd_impl::clamp(5, 0, 3) == 3, "");
+            static_assert(ctd_impl::clamp(-5, 0, 3) == 0, "");
+            static_assert(ctd_impl::clamp(2, 0, 3) == 2, "");
+            static_assert(ctd_impl::minmax(3, 2).first == 2 && ctd_impl::minmax(3, 2).second == 3, "");
+
+            // Like std::min and std::max, the first argument wins a tie.
+            const int a = 1;
+            const int b = 1;
+            EXPECT_EQ(&a, &ctd_impl::min(a, b));
+            EXPECT_EQ(&a, &ctd_impl::max(a, b));
+        }
+
+        TEST(AlgorithmImpl, Sort) {
+            std::mt19937 rng(1);
+            for (size_t n : { 0, 1, 2, 15, 16, 17, 100, 1000 }) {
+                for (int range : { 3, 1000000 }) {
+                    std::vector<int> data(n);
+                    for (auto& x : data) {
+                        x = static_cast<int>(rng() % range);
+                    }
+                    std::vector<int> expected = data;
+                    std::sort(expected.begin(), expected.end());
+                    ctd_impl::sort(data.begin(), data.end());
+                    EXPECT_EQ(expected, data) << "n = " << n;
+                }
+            }
+        }
+
+        TEST(AlgorithmImpl, SortAdversarial) {
+            std::vector<int> data(1000);
+            for (size_t i = 0; i < data.size(); ++i) {
+                data[i] = static_cast<int>(i % 2 ? i : data.size() - i);
+            }
+            std::vector<int> expected = data;
+            std::sort(expected.begin(), expected.end());
+            ctd_impl::sort(data.begin(), data.end(), [](int a, int b) { return a < b; });
+            EXPECT_EQ(expected, data);
+
+            ctd_impl::sort(data.begin(), data.end(), [](int a, int b) { return a > b; });
+            std::reverse(expected.begin(), expected.end());
+            EXPECT_EQ(expected, data);
+        }
+
+        TEST(AlgorithmImpl, NthElement) {
+            std::mt19937 rng(2);
+            for (size_t n : { 1, 9, 17, 100, 1001 }) {
+                std::vector<int> data(n);
+                for (auto& x : data) {
+                    x = static_cast<int>(rng() % 100);
+                }
+                std::vector<int> sorted = data;
+                std::sort(sorted.begin(), sorted.end());
+                for (size_t k : { size_t(0), n / 2, n - 1 }) {
+                    std::vector<int> d = data;
+                    ctd_impl::nth_element(d.begin(), d.begin() + k, d.end());
+                    EXPECT_EQ(sorted[k], d[k]) << "n = " << n << ", k = " << k;
+                    EXPECT_TRUE(std::all_of(d.begin(), d.begin() + k, [&](int x) { return x <= d[k]; }));
+                    EXPECT_TRUE(std::all_of(d.begin() + k, d.end(), [&](int x) { return x >= d[k]; }));
+                }
+            }
+        }
+
+        TEST(AlgorithmImpl, SortConstexpr) {
+            constexpr auto sorted = [] {
+                struct { int v[40]; } a = {};
+                for (int i = 0; i < 40; ++i) {
+                    a.v[i] = (i * 17) % 40;
+                }
+                ctd_impl::sort(a.v, a.v + 40);
+                return a;
+            }();
+            static_assert(sorted.v[0] == 0 && sorted.v[20] == 20 && sorted.v[39] == 39, "");
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,88 @@
+#include "ctd/angle.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cmath>
+
+namespace ctd {
+    namespace {
+        using bam16 = binary_angle<uint16_t>;
+        using bam32 = binary_angle<uint32_t>;
+
+        TEST(BinaryAngle, WrapsAround) {
+            EXPECT_EQ(bam16(464), bam16(65000) + bam16(1000));
+            EXPECT_EQ(bam16(64536), bam16(0) - bam16(1000));
+            EXPECT_EQ(bam16(0), bam16(16384) * 4);
+            EXPECT_EQ(-1000, (bam16(0) - bam16(1000)).signed_count());
+        }
+
+        template <typename A, typename S>
+        concept scalable = requires(A a, S s) { a * s; };
+
+        TEST(BinaryAngle, IntegerMultiples) {
+            EXPECT_EQ(bam16(64536), bam16(1000) * -1);
+            EXPECT_EQ(bam16(1), 2147483647 * bam16(65535));
+            EXPECT_EQ(bam32(4294967295u), bam32(1) * int64_t(-1));
+            static_assert(scalable<bam16, int>, "");
+            static_assert(!scalable<bam16, float>, "");
+            static_assert(!scalable<bam16, bam16>, "");
+        }
+
+        TEST(BinaryAngle, FromDegrees) {
+            EXPECT_EQ(bam16(16384), bam16(angle<int, degree>(90)));
+            EXPECT_EQ(bam16(49152), bam16(angle<int, degree>(-90)));
+            EXPECT_EQ(bam16(16384), bam16(angle<int, degree>(450)));
+            EXPECT_EQ(bam32(0x40000000), bam32(angle<int, degree>(90)));
+        }
+
+        TEST(BinaryAngle, ToDegrees) {
+            angle<int, degree> deg = bam16(16384);
+            EXPECT_EQ(90, deg.count());
+
+            angle<int, degree> deg32 = bam32(0xC0000000);
+            EXPECT_EQ(270, deg32.count());
+        }
+
+        TEST(BinaryAngle, Radians) {
+            EXPECT_EQ(bam16(16384), bam16(angle<double>(1.5707963267948966)));
+            EXPECT_EQ(bam16(10430), bam16(angle<int, milli>(1000)));
+
+            angle<double> rad = bam16(16384);
+            EXPECT_NEAR(1.5707963267948966, rad.count(), 1e-9);
+        }
+
+        TEST(BinaryAngle, SineCardinalPoints) {
+            static_assert(sin(bam16(0)).count() == 0, "");
+            EXPECT_EQ(32767, sin(bam16(16384)).count());
+            EXPECT_EQ(0, sin(bam16(32768)).count());
+            EXPECT_EQ(-32767, sin(bam16(49152)).count());
+            EXPECT_EQ(32767, cos(bam16(0)).count());
+            EXPECT_EQ(-32767, cos(bam16(32768)).count());
+            EXPECT_EQ(2147483647, sin(bam32(0x40000000)).count());
+        }
+
+        TEST(BinaryAngle, SineAccuracy16) {
+            for (uint32_t i = 0; i < 65536; i += 7) {
+                double expected = std::sin(i * 2 * 3.14159265358979323846 / 65536) * 32767;
+                ASSERT_NEAR(expected, sin(bam16(static_cast<uint16_t>(i))).count(), 2.0) << i;
+                expected = std::cos(i * 2 * 3.14159265358979323846 / 65536) * 32767;
+                ASSERT_NEAR(expected, cos(bam16(static_cast<uint16_t>(i))).count(), 2.0) << i;
+            }
+        }
+
+        TEST(BinaryAngle, SineAccuracy32) {
+            for (uint64_t i = 0; i < (uint64_t(1) << 32); i += 999983) {
+                double expected = std::sin(i * 2 * 3.14159265358979323846 / 4294967296.0);
+                auto s = sin<10>(bam32(static_cast<uint32_t>(i)));
+                ASSERT_NEAR(expected, s.count() / 2147483647.0, 3e-6) << i;
+            }
+        }
+
+        TEST(BinaryAngle, SineIsUnitCorrect) {
+            scale<int, milli> s = sin(bam16(16384));
+            EXPECT_EQ(1000, s.count());
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#include "ctd/atomic_quantity.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <thread>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        using charge = quantity<int32_t, units::coulomb, micro>;
+
+        TEST(AtomicQuantity, LoadStoreExchange) {
+            static_assert(sizeof(atomic_quantity<voltage<int16_t, milli>>) == sizeof(int16_t), "");
+            static_assert(atomic_quantity<voltage<int32_t, milli>>::is_always_lock_free, "");
+
+            atomic_quantity<voltage<int16_t, milli>> bus(voltage<int16_t, milli>(12000));
+            EXPECT_EQ(12000, bus.load().count());
+            bus.store(voltage<int16_t, milli>(11950));
+            EXPECT_EQ(11950, bus.load(memory_order_acquire).count());
+            EXPECT_EQ(11950, bus.exchange(voltage<int16_t, milli>(5)).count());
+            const voltage<int16_t, milli> v = bus;
+            EXPECT_EQ(5, v.count());
+        }
+
+        TEST(AtomicQuantity, CompareExchange) {
+            atomic_quantity<current<int32_t, milli>> a(current<int32_t, milli>(10));
+            current<int32_t, milli> expected = 11;
+            EXPECT_FALSE(a.compare_exchange_strong(expected, current<int32_t, milli>(20)));
+            EXPECT_EQ(10, expected.count());
+            EXPECT_TRUE(a.compare_exchange_strong(expected, current<int32_t, milli>(20)));
+            EXPECT_EQ(20, a.load().count());
+        }
+
+        TEST(AtomicQuantity, FetchAddRescales) {
+            atomic_quantity<charge> total(charge(0));
+            EXPECT_EQ(0, total.fetch_add(quantity<int16_t, units::coulomb, milli>(3)).count());
+            EXPECT_EQ(3000, total.load().count());
+            // 1500 nC truncates to 1 uC.
+            total.fetch_add(quantity<int32_t, units::coulomb, nano>(1500));
+            EXPECT_EQ(3001, total.load().count());
+            EXPECT_EQ(3001, total.fetch_sub(quantity<int32_t, units::coulomb, milli>(1)).count());
+            EXPECT_EQ(2010, (total += charge(9)).count());
+            EXPECT_EQ(2009, (total -= charge(1)).count());
+        }
+
+        TEST(AtomicQuantity, FloatingPoint) {
+            atomic_quantity<time<double>> t(time<double>(1.0));
+            t += time<double, milli>(500.0);
+            EXPECT_DOUBLE_EQ(1.5, t.load().count());
+            EXPECT_DOUBLE_EQ(1.5, t.fetch_sub(time<double>(0.25)).count());
+            EXPECT_DOUBLE_EQ(1.25, t.load().count());
+        }
+
+        TEST(AtomicQuantity, ConcurrentCounter) {
+            atomic_quantity<charge> total(charge(0));
+            constexpr int per_thread = 100000;
+            std::vector<std::thread> threads;
+            for (int i = 0; i < 4; ++i) {
+                threads.emplace_back([&] {
+                    for (int n = 0; n < per_thread; ++n) {
+                        total.fetch_add(quantity<int16_t, units::coulomb, milli>(1), memory_order_relaxed);
+                    }
+                });
+            }
+            for (auto& t : threads) {
+                t.join();
+            }
+            EXPECT_EQ(4 * per_thread * 1000, total.load().count());
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,109 @@
+#include "ctd/bounded.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+using namespace ctd::unit_literals;
+
+namespace ctd {
+    namespace {
+        using adc = bounded<voltage<int, milli>, 0, 255>;
+        using offset = bounded<voltage<int, milli>, -50, 50>;
+        using gain = bounded<resistance<int>, 1, 10>;
+
+        TEST(BoundedQuantity, SmallestType) {
+            static_assert(is_same_v<uint8_t, adc::value_type>, "");
+            static_assert(is_same_v<int8_t, offset::value_type>, "");
+            static_assert(is_same_v<int16_t, bounded_quantity<-129, 0, units::volt>::value_type>, "");
+            static_assert(is_same_v<uint32_t, bounded_quantity<0, 65536, units::volt>::value_type>, "");
+            static_assert(is_same_v<int64_t, bounded_quantity<INT32_MIN - 1LL, 0, units::volt>::value_type>, "");
+        }
+
+        TEST(BoundedQuantity, Addition) {
+            auto sum = adc(200) + offset(-30);
+            static_assert(decltype(sum)::min == -50 && decltype(sum)::max == 305, "");
+            static_assert(is_same_v<int16_t, decltype(sum)::value_type>, "");
+            EXPECT_EQ(170, sum.count());
+        }
+
+        TEST(BoundedQuantity, AdditionDifferentScales) {
+            auto sum = bounded<voltage<int, milli>, 0, 100>(5) + bounded<voltage<int>, 0, 2>(2);
+            static_assert(ratio_equal<milli, decltype(sum)::scale>::value, "");
+            static_assert(decltype(sum)::max == 2100, "");
+            EXPECT_EQ(2005, sum.count());
+        }
+
+        TEST(BoundedQuantity, Subtraction) {
+            auto diff = adc(10) - adc(250);
+            static_assert(decltype(diff)::min == -255 && decltype(diff)::max == 255, "");
+            EXPECT_EQ(-240, diff.count());
+        }
+
+        TEST(BoundedQuantity, Multiplication) {
+            auto i = bounded<current<int, milli>, -100, 100>(-100);
+            auto v = i * gain(10);
+            static_assert(is_same_v<units::volt, decltype(v)::units>, "");
+            static_assert(decltype(v)::min == -1000 && decltype(v)::max == 1000, "");
+            static_assert(is_same_v<int16_t, decltype(v)::value_type>, "");
+            EXPECT_EQ(-1000, v.count());
+        }
+
+        TEST(BoundedQuantity, MultiplicationOfNegativesIsUnsigned) {
+            using neg = bounded_quantity<-15, -1, units::unity>;
+            auto p = neg(-15) * neg(-15);
+            static_assert(is_same_v<uint8_t, decltype(p)::value_type>, "");
+            EXPECT_EQ(225, p.count());
+        }
+
+        TEST(BoundedQuantity, MultiplicationOfFullRangeUnsigned) {
+            using u16 = bounded_quantity<0, UINT16_MAX, units::unity>;
+            constexpr auto p = u16(65535) * u16(65535);
+            static_assert(is_same_v<uint32_t, decltype(p)::value_type>, "");
+            static_assert(p.count() == 4294836225u, "");
+
+            using u32 = bounded_quantity<0, UINT32_MAX, units::unity>;
+            constexpr auto sum = u32(UINT32_MAX) + u32(UINT32_MAX);
+            static_assert(sum.count() == 2 * uint64_t(UINT32_MAX), "");
+            EXPECT_EQ(4294836225u, p.count());
+        }
+
+        TEST(BoundedQuantity, Division) {
+            auto i = adc(255) / gain(2);
+            static_assert(is_same_v<units::ampere, decltype(i)::units>, "");
+            static_assert(decltype(i)::min == 0 && decltype(i)::max == 255, "");
+            EXPECT_EQ(127, i.count());
+        }
+
+        TEST(BoundedQuantity, Negation) {
+            auto n = -adc(255);
+            static_assert(decltype(n)::min == -255 && decltype(n)::max == 0, "");
+            EXPECT_EQ(-255, n.count());
+        }
+
+        TEST(BoundedQuantity, Clamped) {
+            EXPECT_EQ(255, adc::clamped(1000).count());
+            EXPECT_EQ(0, adc::clamped(-1).count());
+            EXPECT_EQ(-50, offset::clamped(-1000L).count());
+            EXPECT_EQ(50, offset::clamped(4000000000u).count());
+            EXPECT_EQ(12, offset::clamped(12_mV).count());
+        }
+
+        TEST(BoundedQuantity, WideningAndComparison) {
+            bounded<voltage<int, milli>, -1000, 1000> wide = adc(12);
+            EXPECT_EQ(12, wide.count());
+            EXPECT_TRUE(wide == adc(12));
+            EXPECT_TRUE(offset(-1) < adc(0));
+            EXPECT_TRUE(adc(0) > offset(-1));
+            EXPECT_TRUE(adc(12) <= wide);
+            EXPECT_TRUE(offset(-1) <= adc(0));
+            EXPECT_TRUE(wide >= adc(12));
+            EXPECT_FALSE(offset(-1) >= adc(0));
+            EXPECT_TRUE(offset(-1) != adc(0));
+            EXPECT_FALSE(wide != adc(12));
+
+            voltage<int, milli> plain = adc(42);
+            EXPECT_EQ(42_mV, plain);
+        }
+    }
+}
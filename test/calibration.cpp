@@ -0,0 +1,63 @@
+#include "ctd/calibration.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cmath>
+
+namespace ctd {
+    namespace {
+        using ohm_per_kelvin = units::detail::unit_powers_subtract<units::ohm, units::kelvin>;
+        using ohm_per_kelvin2 = units::detail::unit_powers_subtract<ohm_per_kelvin, units::kelvin>;
+
+        // Callendar-Van Dusen equation of a PT100 above 0 degrees Celsius, R(T) = R0 * (1 + A*T + B*T^2).
+        using pt100_c0 = coefficient<100, units::ohm>;
+        using pt100_c1 = coefficient<39083, ohm_per_kelvin, ratio<1, 100000>>;
+        using pt100_c2 = coefficient<-5775, ohm_per_kelvin2, ratio<1, 100000000>>;
+
+        double pt100(double t) { return 100.0 * (1 + 3.9083e-3 * t - 5.775e-7 * t * t); }
+
+        TEST(CalibrationPolynomial, Pt100) {
+            using input = temperature<int16_t, centi>;
+            using output = resistance<int32_t, milli>;
+            constexpr calibration_polynomial<input, output, pt100_c0, pt100_c1, pt100_c2> poly;
+
+            static_assert(poly(input(0)).count() == 100000, "");
+            for (int t = INT16_MIN; t <= INT16_MAX; ++t) {
+                const double expected = pt100(t / 100.0) * 1000;
+                ASSERT_NEAR(expected, poly(input(static_cast<int16_t>(t))).count(), 0.5 + 1e-6) << t;
+            }
+        }
+
+        TEST(CalibrationPolynomial, Int32Accumulator) {
+            using input = temperature<int16_t, deci>;
+            using output = resistance<int32_t, milli>;
+            constexpr basic_calibration_polynomial<input, output, int32_t, pt100_c0, pt100_c1, pt100_c2> poly;
+            for (int t = INT16_MIN; t <= INT16_MAX; ++t) {
+                const double expected = pt100(t / 10.0) * 1000;
+                ASSERT_NEAR(expected, poly(input(static_cast<int16_t>(t))).count(), 1.0) << t;
+            }
+        }
+
+        TEST(CalibrationPolynomial, Linear) {
+            // An ADC with 4096 counts over 3.3 V, as millivolts.
+            using lsb = ratio<3300, 4096>;
+            using input = quantity<uint16_t, units::unity, ratio<1>>;
+            using output = voltage<int16_t, milli>;
+            constexpr calibration_polynomial<input, output, coefficient<0, units::volt>,
+                coefficient<1, units::volt, ratio_divide<lsb, ratio<1000>>>> adc;
+            EXPECT_EQ(output(0), adc(input(0)));
+            EXPECT_EQ(output(1650), adc(input(2048)));
+            EXPECT_EQ(output(3299), adc(input(4095)));
+            EXPECT_EQ(output(1), adc(input(1)));
+        }
+
+        TEST(CalibrationPolynomial, Float) {
+            using input = temperature<double>;
+            using output = resistance<double>;
+            constexpr calibration_polynomial<input, output, pt100_c0, pt100_c1, pt100_c2> poly;
+            EXPECT_DOUBLE_EQ(pt100(100.0), poly(input(100.0)).count());
+        }
+    }  // namespace
+}  // namespace ctd
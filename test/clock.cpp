@@ -0,0 +1,47 @@
+#include "ctd/clock.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+using namespace ctd::unit_literals;
+
+namespace ctd {
+    namespace {
+        struct fake_timer {
+            static inline uint16_t value = 0;
+            static uint16_t read() { return value; }
+        };
+
+        using clock = tick_clock<32768, fake_timer>;
+
+        TEST(TickClock, DurationIsInTicks) {
+            fake_timer::value = 100;
+            auto start = clock::now();
+            fake_timer::value = 132;
+
+            auto elapsed = clock::elapsed_since(start);
+            static_assert(is_same_v<time<uint16_t, ratio<1, 32768>>, decltype(elapsed)>, "");
+            EXPECT_EQ(32, elapsed.count());
+
+            time<int, micro> us = elapsed;
+            EXPECT_EQ(976, us.count());
+        }
+
+        TEST(TickClock, WrapAround) {
+            fake_timer::value = 65530;
+            auto start = clock::now();
+            fake_timer::value = 10;
+            EXPECT_EQ(16, (clock::now() - start).count());
+        }
+
+        TEST(TickClock, Deadlines) {
+            auto deadline = clock::time_point(65530) + time<uint16_t, ratio<1, 32768>>(100);
+            EXPECT_EQ(94, deadline.ticks());
+            EXPECT_FALSE(clock::reached(deadline, clock::time_point(65531)));
+            EXPECT_FALSE(clock::reached(deadline, clock::time_point(93)));
+            EXPECT_TRUE(clock::reached(deadline, clock::time_point(94)));
+            EXPECT_TRUE(clock::reached(deadline, clock::time_point(1000)));
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#include "ctd/cmath.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cstdint>
+
+namespace ctd {
+    namespace {
+        TEST(IntegerSqrt, Exhaustive16) {
+            for (uint32_t i = 0; i < 65536; ++i) {
+                uint16_t r = isqrt(static_cast<uint16_t>(i));
+                ASSERT_LE(uint32_t(r) * r, i);
+                ASSERT_GT(uint32_t(r + 1) * (r + 1), i);
+            }
+        }
+
+        TEST(IntegerSqrt, Wide) {
+            static_assert(isqrt(int64_t(999999999999999999)) == 999999999, "");
+            EXPECT_EQ(4294967295u, isqrt(uint64_t(18446744073709551615u)));
+            EXPECT_EQ(46340, isqrt(int32_t(2147483647)));
+            EXPECT_EQ(0, isqrt(-4));
+        }
+
+        TEST(IntegerCbrt, Exhaustive16) {
+            for (int32_t i = -32768; i < 32768; ++i) {
+                int16_t r = icbrt(static_cast<int16_t>(i));
+                int32_t a = i < 0 ? -i : i;
+                int32_t ra = r < 0 ? -r : r;
+                ASSERT_LE(ra * ra * ra, a);
+                ASSERT_GT((ra + 1) * (ra + 1) * (ra + 1), a);
+            }
+        }
+
+        TEST(IntegerCbrt, Wide) {
+            static_assert(icbrt(int64_t(1000000000000000000)) == 1000000, "");
+            EXPECT_EQ(2642245u, icbrt(uint64_t(18446744073709551615u)));
+            EXPECT_EQ(1625, icbrt(uint32_t(4294967295u)));
+        }
+    }
+}
@@ -0,0 +1,166 @@
+#include "ctd/column_codec.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        template <typename Q, delta_order Order = delta_order::delta>
+        std::vector<Q> round_trip(const std::vector<Q>& in, size_t* bytes = nullptr) {
+            using codec = column_codec<Q, Order>;
+            std::vector<uint8_t> buf(codec::max_bytes(in.size()));
+            const size_t n = codec::encode(in.data(), in.size(), buf.data());
+            if (bytes) {
+                *bytes = n;
+            }
+            std::vector<Q> out(in.size());
+            out.resize(codec::decode(buf.data(), n, out.data(), out.size()));
+            return out;
+        }
+
+        // A slowly varying signal with a few LSB of noise, like a logged ADC channel.
+        template <typename Q>
+        std::vector<Q> random_walk(size_t n, int step, int64_t start = 0) {
+            std::srand(42);
+            std::vector<Q> v;
+            int64_t x = start;
+            for (size_t i = 0; i < n; ++i) {
+                x += std::rand() % (2 * step + 1) - step;
+                v.push_back(Q(static_cast<typename Q::value_type>(x)));
+            }
+            return v;
+        }
+
+        TEST(ColumnCodec, RoundTripsPartialBlocks) {
+            using sample = voltage<int16_t, milli>;
+            for (size_t n : { 1, 2, 127, 128, 129, 1000 }) {
+                const auto in = random_walk<sample>(n, 3, 12000);
+                EXPECT_EQ(in, round_trip(in)) << n;
+            }
+        }
+
+        TEST(ColumnCodec, CompressesSlowSignals) {
+            const auto in = random_walk<current<int32_t, micro>>(4096, 7, 500000);
+            size_t bytes = 0;
+            EXPECT_EQ(in, round_trip(in, &bytes));
+            // 4 bit residuals and a 12 byte header per 128 samples.
+            EXPECT_GE(in.size() * sizeof(int32_t), 6 * bytes);
+        }
+
+        TEST(ColumnCodec, WideAndWrappingResiduals) {
+            using q = length<int64_t, micro>;
+            std::vector<q> in;
+            for (int64_t x : { INT64_MIN, INT64_MAX, int64_t(0), int64_t(-1), INT64_MAX, int64_t(1) << 40 }) {
+                in.push_back(q(x));
+            }
+            EXPECT_EQ(in, round_trip(in));
+            EXPECT_EQ(in, (round_trip<q, delta_order::delta_of_delta>(in)));
+
+            std::vector<quantity<int8_t, units::unity, ratio<1>>> bytes;
+            for (int i = -127; i < 128; i += 50) {
+                bytes.push_back(static_cast<int8_t>(i));
+            }
+            EXPECT_EQ(bytes, round_trip(bytes));
+        }
+
+        TEST(ColumnCodec, DeltaOfDeltaPacksRamps) {
+            using stamp = time<int64_t, micro>;
+            using codec = column_codec<stamp, delta_order::delta_of_delta>;
+            std::vector<stamp> in;
+            for (int64_t i = 0; i < 128; ++i) {
+                in.push_back(stamp(1700000000000000 + 1000 * i));
+            }
+            uint8_t buf[codec::max_block_bytes];
+            const size_t bytes = codec::encode_block(in.data(), in.size(), buf);
+            // A constant slope is all in the header.
+            EXPECT_EQ(0, buf[0] & 0x7F);
+            EXPECT_EQ(bytes, codec::block_bytes(buf, bytes));
+            stamp out[codec::block_size];
+            ASSERT_EQ(128u, codec::decode_block(buf, bytes, out));
+            EXPECT_TRUE(std::equal(in.begin(), in.end(), out));
+
+            const size_t delta_bytes = column_codec<stamp>::encode_block(in.data(), in.size(), buf);
+            EXPECT_LT(bytes, delta_bytes);
+        }
+
+        TEST(ColumnCodec, RandomAccessByBlock) {
+            using sample = temperature<int32_t, milli>;
+            using codec = column_codec<sample>;
+            const auto in = random_walk<sample>(1000, 50, 293150);
+            std::vector<uint8_t> buf(codec::max_bytes(in.size()));
+            size_t offsets[8];
+            const size_t bytes = codec::encode(in.data(), in.size(), buf.data(), offsets);
+
+            sample out[codec::block_size];
+            ASSERT_EQ(128u, codec::decode_block(buf.data() + offsets[5], offsets[6] - offsets[5], out));
+            EXPECT_TRUE(std::equal(out, out + 128, in.begin() + 5 * 128));
+            ASSERT_EQ(1000u - 7 * 128, codec::decode_block(buf.data() + offsets[7], bytes - offsets[7], out));
+            EXPECT_TRUE(std::equal(out, out + 1000 - 7 * 128, in.begin() + 7 * 128));
+        }
+
+        TEST(ColumnCodec, RejectsOtherUnitsAndScales) {
+            const auto in = random_walk<voltage<int16_t, milli>>(100, 3);
+            uint8_t buf[column_codec<voltage<int16_t, milli>>::max_block_bytes];
+            const size_t bytes = column_codec<voltage<int16_t, milli>>::encode_block(in.data(), in.size(), buf);
+
+            voltage<int16_t, micro> scaled[128];
+            EXPECT_EQ(0u, (column_codec<voltage<int16_t, micro>>::decode_block(buf, bytes, scaled)));
+            current<int16_t, milli> other[128];
+            EXPECT_EQ(0u, (column_codec<current<int16_t, milli>>::decode_block(buf, bytes, other)));
+        }
+
+        TEST(ColumnCodec, DecodesIntoExactCapacity) {
+            using sample = voltage<int16_t, milli>;
+            using codec = column_codec<sample>;
+            const auto in = random_walk<sample>(1000, 3);
+            std::vector<uint8_t> buf(codec::max_bytes(in.size()));
+            const size_t bytes = codec::encode(in.data(), in.size(), buf.data());
+
+            std::vector<sample> out(in.size());
+            ASSERT_EQ(1000u, codec::decode(buf.data(), bytes, out.data(), out.size()));
+            EXPECT_EQ(in, out);
+            // Blocks are never split, the last one of 104 samples doesn't fit in 999.
+            EXPECT_EQ(7u * 128, codec::decode(buf.data(), bytes, out.data(), 999));
+        }
+
+        TEST(ColumnCodec, StopsAtTruncatedBlocks) {
+            using sample = temperature<int32_t, milli>;
+            using codec = column_codec<sample, delta_order::delta_of_delta>;
+            const auto in = random_walk<sample>(200, 50, 293150);
+            std::vector<uint8_t> buf(codec::max_bytes(in.size()));
+            size_t offsets[2];
+            const size_t bytes = codec::encode(in.data(), in.size(), buf.data(), offsets);
+
+            std::vector<sample> out(in.size());
+            EXPECT_EQ(128u, codec::decode(buf.data(), bytes - 1, out.data(), out.size()));
+            EXPECT_EQ(0u, codec::block_bytes(buf.data() + offsets[1], bytes - offsets[1] - 1));
+            // Every cut through the header of the second block is detected without reading past it.
+            for (size_t size = 0; size < 12; ++size) {
+                std::vector<uint8_t> header(buf.begin() + offsets[1], buf.begin() + offsets[1] + size);
+                EXPECT_EQ(0u, codec::block_bytes(header.data(), header.size())) << size;
+                EXPECT_EQ(0u, codec::decode_block(header.data(), header.size(), out.data())) << size;
+            }
+        }
+
+        TEST(ColumnCodec, ScalarUnpackMatches) {
+            uint32_t values[128];
+            uint32_t out[128];
+            uint8_t packed[4 * 128];
+            for (int bits = 1; bits <= 32; ++bits) {
+                for (size_t i = 0; i < 128; ++i) {
+                    values[i] = static_cast<uint32_t>(i * 2654435761u) >> (32 - bits);
+                }
+                detail::pack_lanes(values, bits, packed);
+                detail::unpack_lanes(packed, bits, out);
+                EXPECT_TRUE(std::equal(values, values + 128, out)) << bits;
+                detail::unpack_lanes_scalar(packed, bits, out);
+                EXPECT_TRUE(std::equal(values, values + 128, out)) << bits;
+            }
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,104 @@
+#include "ctd/complex.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cmath>
+#include <complex>
+
+namespace ctd {
+    namespace {
+        using phasor = std::complex<double>;
+
+        TEST(ComplexQuantity, AddsAcrossScales) {
+            const voltage<phasor> a(phasor(1.0, 2.0));
+            const voltage<phasor, milli> b(phasor(500.0, -250.0));
+            const voltage<phasor, milli> sum = a + b;
+            EXPECT_DOUBLE_EQ(1500.0, sum.count().real());
+            EXPECT_DOUBLE_EQ(1750.0, sum.count().imag());
+            EXPECT_TRUE((voltage<phasor>(phasor(1.0, 2.0)) == voltage<phasor, milli>(phasor(1000.0, 2000.0))));
+        }
+
+        TEST(ComplexQuantity, ConvertsBetweenScales) {
+            const voltage<phasor, milli> mv = voltage<phasor>(phasor(1.5, -0.25));
+            EXPECT_DOUBLE_EQ(1500.0, mv.count().real());
+            EXPECT_DOUBLE_EQ(-250.0, mv.count().imag());
+        }
+
+        TEST(ComplexQuantity, ImpedanceFromPhasors) {
+            const voltage<phasor> v(phasor(10.0, 0.0));
+            const current<phasor> i(phasor(1.0, 1.0));
+            const resistance<phasor> z = v / i;
+            EXPECT_DOUBLE_EQ(5.0, real(z).count());
+            EXPECT_DOUBLE_EQ(-5.0, imag(z).count());
+            EXPECT_DOUBLE_EQ(std::sqrt(50.0), abs(z).count());
+            EXPECT_DOUBLE_EQ(-std::atan(1.0), arg(z).count());
+            EXPECT_DOUBLE_EQ(5.0, imag(conj(z)).count());
+        }
+
+        TEST(FixedComplex, ProductMatchesFourMultiplies) {
+            for (int a = -32767; a <= 32767; a += 4099) {
+                for (int b = -32767; b <= 32767; b += 5003) {
+                    const fixed_complex<int16_t> x{ int16_t(a), int16_t(b) };
+                    const fixed_complex<int16_t> y(int16_t(b / 3), int16_t(-a / 2));
+                    const fixed_complex<int32_t> p = x * y;
+                    EXPECT_EQ(a * (b / 3) - b * (-a / 2), p.real());
+                    EXPECT_EQ(a * (-a / 2) + b * (b / 3), p.imag());
+                }
+            }
+        }
+
+        TEST(FixedComplex, Division) {
+            const fixed_complex<int16_t> x(300, 400);
+            const fixed_complex<int16_t> y(3, 4);
+            EXPECT_EQ(fixed_complex<int32_t>(100, 0), x / y);
+            EXPECT_EQ(fixed_complex<int32_t>(150, 200), x / 2);
+            EXPECT_EQ(fixed_complex<int32_t>(600, 800), x * 2);
+        }
+
+        TEST(FixedComplex, CordicMagnitudeAndPhase) {
+            constexpr double two_pi = 6.283185307179586;
+            for (int a = -32767; a <= 32767; a += 1021) {
+                for (int b = -32767; b <= 32767; b += 1523) {
+                    const fixed_complex<int16_t> z{ int16_t(a), int16_t(b) };
+                    const std::complex<double> ref(a, b);
+                    EXPECT_NEAR(std::abs(ref), double(abs(z)), 1.0);
+                    double expected = std::arg(ref) / two_pi * 65536.0;
+                    double err = std::fmod(double(arg(z).count()) - expected + 65536.0 * 2, 65536.0);
+                    EXPECT_LE(err < 32768.0 ? err : 65536.0 - err, 2.0);
+                }
+            }
+        }
+
+        TEST(FixedComplex, CordicThirtyTwoBit) {
+            const fixed_complex<int32_t> z(-2000000000, 1500000000);
+            const std::complex<double> ref(-2000000000.0, 1500000000.0);
+            EXPECT_NEAR(std::abs(ref), double(abs(z)), 1.0);
+            const double expected = std::arg(ref) / 6.283185307179586 * 4294967296.0;
+            EXPECT_NEAR(expected, double(arg(z).signed_count()), 4.0);
+        }
+
+        TEST(FixedComplex, CordicOfZero) {
+            static_assert(arg(fixed_complex<int16_t>(0, 0)).count() == 0, "");
+            static_assert(abs(fixed_complex<int16_t>(0, 0)) == 0, "");
+            EXPECT_EQ(0u, arg(fixed_complex<int8_t>(0, 0)).count());
+            EXPECT_EQ(0u, arg(fixed_complex<int32_t>(0, 0)).count());
+            EXPECT_EQ(0, abs(fixed_complex<int32_t>(0, 0)));
+        }
+
+        TEST(FixedComplex, QuantityUnits) {
+            using phasor16 = fixed_complex<int16_t>;
+            const voltage<phasor16, milli> v(phasor16(3000, 4000));
+            const current<phasor16, milli> i(phasor16(100, 0));
+            const auto p = v * i;
+            static_assert(is_same_v<typename decltype(p)::units, units::watt>, "");
+            EXPECT_EQ((fixed_complex<int32_t>(300000, 400000)), p.count());
+            const voltage<int32_t, milli> m = abs(v);
+            EXPECT_EQ(5000, m.count());
+            EXPECT_EQ(binary_angle<uint16_t>(uint16_t(0)), arg(i));
+            const voltage<phasor16> sum = voltage<phasor16>(phasor16(1, 1)) + voltage<phasor16>(phasor16(2, -1));
+            EXPECT_EQ(phasor16(3, 0), sum.count());
+        }
+    }  // namespace
+}  // namespace ctd
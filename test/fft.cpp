@@ -0,0 +1,171 @@
+#include "ctd/fft.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        constexpr double pi = 3.14159265358979323846;
+
+        // The normalized DFT, X[k] / N, by definition.
+        std::vector<std::complex<double>> reference(const std::vector<std::complex<double>>& x) {
+            const size_t n = x.size();
+            std::vector<std::complex<double>> ans(n);
+            for (size_t k = 0; k < n; ++k) {
+                for (size_t j = 0; j < n; ++j) {
+                    ans[k] += x[j] * std::polar(1.0, -2 * pi * double((k * j) % n) / double(n));
+                }
+                ans[k] /= double(n);
+            }
+            return ans;
+        }
+
+        template <size_t N>
+        void check_float() {
+            using Q = voltage<std::complex<float>, milli>;
+            std::srand(3);
+            std::vector<std::complex<double>> x(N);
+            Q data[N];
+            for (size_t i = 0; i < N; ++i) {
+                x[i] = { std::rand() % 2001 - 1000.0, std::rand() % 2001 - 1000.0 };
+                data[i] = Q(std::complex<float>(x[i]));
+            }
+            fft<N>(data);
+            const auto expected = reference(x);
+            for (size_t k = 0; k < N; ++k) {
+                ASSERT_NEAR(expected[k].real(), data[k].count().real(), 1e-3) << k;
+                ASSERT_NEAR(expected[k].imag(), data[k].count().imag(), 1e-3) << k;
+            }
+        }
+
+        template <typename T, size_t N>
+        void check_fixed(double amplitude, double tolerance) {
+            using Q = voltage<fixed_complex<T>, micro>;
+            std::srand(5);
+            std::vector<std::complex<double>> x(N);
+            Q data[N];
+            for (size_t i = 0; i < N; ++i) {
+                // A real signal, two tones and noise.
+                const double v = amplitude * (0.5 * std::sin(2 * pi * 5 * double(i) / N) +
+                                                 0.3 * std::cos(2 * pi * 17 * double(i) / N) +
+                                                 0.1 * (std::rand() % 2001 - 1000) / 1000.0);
+                x[i] = std::round(v);
+                data[i] = Q(fixed_complex<T>(static_cast<T>(x[i].real())));
+            }
+            fft<N>(data);
+            const auto expected = reference(x);
+            for (size_t k = 0; k < N; ++k) {
+                ASSERT_NEAR(expected[k].real(), double(data[k].count().real()), tolerance) << k;
+                ASSERT_NEAR(expected[k].imag(), double(data[k].count().imag()), tolerance) << k;
+            }
+        }
+
+        TEST(Fft, FloatMatchesDft) {
+            check_float<4>();
+            check_float<8>();
+            check_float<64>();
+            check_float<128>();
+        }
+
+        TEST(Fft, Q15MatchesDft) {
+            check_fixed<int16_t, 16>(32767, 3);
+            check_fixed<int16_t, 256>(32767, 4);
+            check_fixed<int16_t, 512>(32767, 4);
+        }
+
+        TEST(Fft, Q31MatchesDft) {
+            check_fixed<int32_t, 64>(2147483647, 4);
+            check_fixed<int32_t, 1024>(2147483647, 4);
+        }
+
+        TEST(Fft, ToneLandsInItsBin) {
+            constexpr size_t n = 64;
+            voltage<fixed_complex<int16_t>, milli> data[n];
+            for (size_t i = 0; i < n; ++i) {
+                const long v = std::lround(8000 * std::cos(2 * pi * 4 * i / n));
+                data[i] = fixed_complex<int16_t>(static_cast<int16_t>(v));
+            }
+            fft<n>(data);
+            // A cosine of amplitude A has A / 2 in bins k and N - k.
+            EXPECT_NEAR(4000, data[4].count().real(), 2);
+            EXPECT_NEAR(4000, data[n - 4].count().real(), 2);
+            EXPECT_NEAR(0, data[5].count().real(), 2);
+        }
+
+        TEST(Fft, Constexpr) {
+            constexpr auto x = [] {
+                current<fixed_complex<int16_t>> data[4] = { fixed_complex<int16_t>(400), fixed_complex<int16_t>(0),
+                    fixed_complex<int16_t>(0), fixed_complex<int16_t>(0) };
+                fft<4>(data);
+                return data[3].count();
+            }();
+            static_assert(x.real() == 100 && x.imag() == 0, "");
+        }
+
+        TEST(PowerSpectrum, UnitsAndParseval) {
+            constexpr size_t n = 256;
+            using sample = voltage<fixed_complex<int16_t>, milli>;
+            using rate = ratio<8000>;
+            using power = power_spectrum_t<sample>;
+            using density = power_spectral_density_t<sample, n, rate>;
+            static_assert(is_same_v<power::units, units::detail::unit_powers_add<units::volt, units::volt>>, "");
+            static_assert(is_same_v<density::units,
+                              units::detail::unit_powers_subtract<power::units, units::hertz>>, "");
+            static_assert(is_same_v<power::scale, ratio<1, 1000000>>, "");
+            // mV^2 * 256 / 8000 Hz
+            static_assert(is_same_v<density::scale, ratio<1, 31250000>>, "");
+
+            sample data[n];
+            double mean_square = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const double v = 1000 * std::sin(2 * pi * 10 * i / n) + 500;
+                mean_square += v * v / n;
+                data[i] = fixed_complex<int16_t>(static_cast<int16_t>(std::lround(v)));
+            }
+            fft<n>(data);
+            power p[n / 2 + 1];
+            power_spectrum<n>(data, p);
+            int64_t total = 0;
+            for (const auto& b : p) {
+                total += b.count();
+            }
+            EXPECT_NEAR(mean_square, double(total), mean_square * 1e-3);
+            EXPECT_NEAR(250000, double(p[0].count()), 100);
+            EXPECT_NEAR(500000, double(p[10].count()), 500);
+
+            density d[n / 2 + 1];
+            power_spectral_density<n, rate>(data, d);
+            EXPECT_EQ(p[10].count(), d[10].count());
+            // 0.5 V^2 in one bin of 31.25 Hz.
+            const quantity<double, density::units, ratio<1>> si = d[10];
+            EXPECT_NEAR(0.5 / 31.25, si.count(), 1e-4);
+        }
+
+        TEST(PowerSpectrum, Q31AndFloat) {
+            constexpr size_t n = 16;
+            current<fixed_complex<int32_t>> fixed[n];
+            current<std::complex<float>> floating[n];
+            for (size_t i = 0; i < n; ++i) {
+                fixed[i] = fixed_complex<int32_t>(i % 2 ? 1 << 30 : -(1 << 30));
+                floating[i] = std::complex<float>(i % 2 ? 1.0f : -1.0f);
+            }
+            fft<n>(fixed);
+            fft<n>(floating);
+            power_spectrum_t<current<fixed_complex<int32_t>>> pf[n / 2 + 1];
+            power_spectrum_t<current<std::complex<float>>> pd[n / 2 + 1];
+            power_spectrum<n>(fixed, pf);
+            power_spectrum<n>(floating, pd);
+            EXPECT_NEAR(double(int64_t(1) << 58), double(pf[n / 2].count()), 1e-8 * double(int64_t(1) << 58));
+            EXPECT_FLOAT_EQ(1.0f, pd[n / 2].count());
+            using fixed_power = power_spectrum_t<current<fixed_complex<int32_t>>>;
+            const quantity<double, fixed_power::units, ratio<1>> fixed_si = pf[n / 2];
+            EXPECT_NEAR(double(int64_t(1) << 60), fixed_si.count(), 1e-8 * double(int64_t(1) << 60));
+        }
+    }  // namespace
+}  // namespace ctd
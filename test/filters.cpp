@@ -0,0 +1,143 @@
+#include "ctd/filters.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        using namespace ctd::unit_literals;
+        using sample = voltage<int16_t, milli>;
+
+        TEST(MovingAverage, AccumulatorCannotOverflow) {
+            static_assert(is_same_v<int32_t, moving_average<sample, 16>::sum_type::value_type>, "");
+            static_assert(is_same_v<uint16_t, moving_average<voltage<uint8_t, milli>, 64>::sum_type::value_type>, "");
+
+            moving_average<sample, 64> avg;
+            for (int i = 0; i < 100; ++i) {
+                EXPECT_EQ(sample(INT16_MAX), avg.push(sample(INT16_MAX)));
+            }
+            EXPECT_EQ(64 * INT16_MAX, avg.sum().count());
+        }
+
+        TEST(MovingAverage, Window) {
+            moving_average<sample, 4> avg;
+            EXPECT_EQ(10_mV, avg.push(10_mV));
+            EXPECT_EQ(15_mV, avg.push(20_mV));
+            EXPECT_EQ(20_mV, avg.push(30_mV));
+            EXPECT_FALSE(avg.full());
+            EXPECT_EQ(25_mV, avg.push(40_mV));
+            EXPECT_TRUE(avg.full());
+            EXPECT_EQ(35_mV, avg.push(50_mV));
+            EXPECT_EQ(140_mV, avg.sum());
+        }
+
+        TEST(MovingAverage, RoundsToNearest) {
+            moving_average<sample, 4> avg;
+            avg.push(1_mV);
+            avg.push(2_mV);
+            avg.push(2_mV);
+            EXPECT_EQ(2_mV, avg.push(1_mV));
+            avg.push(-1_mV);
+            avg.push(-2_mV);
+            avg.push(-2_mV);
+            EXPECT_EQ(-2_mV, avg.push(-1_mV));
+        }
+
+        TEST(ExponentialSmoothing, StepResponse) {
+            exponential_smoothing<sample, ratio<1, 8>> ema;
+            EXPECT_EQ(0_mV, ema.push(0_mV));
+            // y[k] = 1000 * (1 - (7/8)^k)
+            EXPECT_EQ(125_mV, ema.push(1000_mV));
+            EXPECT_EQ(234_mV, ema.push(1000_mV));
+            for (int i = 0; i < 200; ++i) {
+                ema.push(1000_mV);
+            }
+            // The internal fraction bits let the output settle exactly instead of stalling a few LSB short.
+            EXPECT_EQ(1000_mV, ema.value());
+        }
+
+        TEST(ExponentialSmoothing, NegativeAndNonPowerOfTwo) {
+            exponential_smoothing<sample, ratio<2, 10>> ema(0_mV);
+            EXPECT_EQ(-200_mV, ema.push(-1000_mV));
+            EXPECT_EQ(-360_mV, ema.push(-1000_mV));
+            for (int i = 0; i < 200; ++i) {
+                ema.push(-1000_mV);
+            }
+            EXPECT_EQ(-1000_mV, ema.value());
+        }
+
+        TEST(ExponentialSmoothing, Float) {
+            exponential_smoothing<voltage<double>, ratio<1, 4>> ema(voltage<double>(0.0));
+            EXPECT_DOUBLE_EQ(1.0, ema.push(voltage<double>(4.0)).count());
+            EXPECT_DOUBLE_EQ(1.75, ema.push(voltage<double>(4.0)).count());
+        }
+
+        TEST(RunningVariance, SquaredUnits) {
+            running_variance<sample> var;
+            for (int16_t x : { 2, 4, 4, 4, 5, 5, 7, 9 }) {
+                var.push(sample(x));
+            }
+            static_assert(is_same_v<ratio<1, 1000000>, decltype(var.variance())::scale>, "");
+            EXPECT_EQ(8u, var.count());
+            EXPECT_FLOAT_EQ(5.0f, var.mean().count());
+            EXPECT_FLOAT_EQ(4.0f, var.variance().count());
+            EXPECT_FLOAT_EQ(32.0f / 7, var.sample_variance().count());
+
+            const voltage<float, milli> sd = var.standard_deviation();
+            EXPECT_FLOAT_EQ(2.0f, sd.count());
+        }
+
+        TEST(RunningVariance, LargeOffset) {
+            // The naive sum of squares loses all precision here.
+            running_variance<voltage<double>> var;
+            for (int i = 0; i < 1000; ++i) {
+                var.push(voltage<double>(1e9 + (i % 2 ? 1 : -1)));
+            }
+            EXPECT_NEAR(1.0, var.variance().count(), 1e-6);
+        }
+
+        TEST(RunningMedian, Window) {
+            running_median<sample, 5> med;
+            EXPECT_EQ(5_mV, med.push(5_mV));
+            EXPECT_EQ(5_mV, med.push(1_mV));
+            EXPECT_EQ(5_mV, med.push(9_mV));
+            EXPECT_EQ(5_mV, med.push(3_mV));
+            EXPECT_EQ(5_mV, med.push(7_mV));
+            // 5 drops out of the window.
+            EXPECT_EQ(3_mV, med.push(2_mV));
+            // A spike only moves the median to the next reading.
+            EXPECT_EQ(7_mV, med.push(1000_mV));
+        }
+
+        TEST(RunningMedian, MatchesSortedWindow) {
+            std::mt19937 rng(3);
+            for (size_t window : { 1, 2, 7, 8, 31 }) {
+                std::vector<int16_t> input(500);
+                for (auto& x : input) {
+                    x = static_cast<int16_t>(rng() % 50 - 25);
+                }
+                auto check = [&](auto& med) {
+                    for (size_t i = 0; i < input.size(); ++i) {
+                        const sample m = med.push(sample(input[i]));
+                        const size_t first = i + 1 > window ? i + 1 - window : 0;
+                        std::vector<int16_t> w(input.begin() + first, input.begin() + i + 1);
+                        std::sort(w.begin(), w.end());
+                        ASSERT_EQ(sample(w[w.size() / 2]), m) << "window = " << window << ", i = " << i;
+                    }
+                };
+                switch (window) {
+                case 1: { running_median<sample, 1> m; check(m); break; }
+                case 2: { running_median<sample, 2> m; check(m); break; }
+                case 7: { running_median<sample, 7> m; check(m); break; }
+                case 8: { running_median<sample, 8> m; check(m); break; }
+                default: { running_median<sample, 31> m; check(m); break; }
+                }
+            }
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,86 @@
+#include "ctd/units.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <sstream>
+
+namespace ctd {
+    namespace {
+        const instrument::conversion_counters* find(intmax_t from_num, intmax_t from_den, intmax_t to_num,
+            intmax_t to_den, int digits) {
+            const instrument::conversion_counters* found = nullptr;
+            instrument::for_each([&](const instrument::conversion_counters& c) {
+                if (c.from_num == from_num && c.from_den == from_den && c.to_num == to_num && c.to_den == to_den &&
+                    c.digits == digits) {
+                    found = &c;
+                }
+            });
+            return found;
+        }
+
+        TEST(Instrument, CountsConversionsPerCombination) {
+            instrument::reset();
+            volatile int16_t counts[] = { 1234, -1234, 1000 };
+            for (int16_t c : counts) {
+                const voltage<int16_t, milli> mv(c);
+                const voltage<int16_t, centi> cv = mv;
+                const voltage<int32_t, micro> uv = voltage<int32_t, milli>(c);
+                (void)cv;
+                (void)uv;
+            }
+
+            const auto* down = find(1, 1000, 1, 100, 15);
+            ASSERT_NE(nullptr, down);
+            EXPECT_EQ(3u, down->conversions);
+            EXPECT_EQ(3u, down->divides);
+            EXPECT_EQ(2u, down->inexact);
+            EXPECT_FLOAT_EQ(0.4f, down->max_error);
+            EXPECT_FLOAT_EQ(0.8f, down->total_error);
+            EXPECT_EQ(0u, down->overflow);
+
+            const auto* up = find(1, 1000, 1, 1000000, 31);
+            ASSERT_NE(nullptr, up);
+            EXPECT_EQ(3u, up->conversions);
+            EXPECT_EQ(0u, up->divides);
+            EXPECT_EQ(0u, up->inexact);
+        }
+
+        TEST(Instrument, ConstantEvaluationIsNotCounted) {
+            instrument::reset();
+            constexpr voltage<int16_t, centi> cv = voltage<int16_t, milli>(500);
+            static_assert(cv.count() == 50, "");
+            const auto* c = find(1, 1000, 1, 100, 15);
+            EXPECT_TRUE(c == nullptr || c->conversions == 0);
+        }
+
+        TEST(Instrument, Overflow) {
+            instrument::reset();
+            volatile int16_t counts[] = { 10, 20, 40 };
+            for (int16_t c : counts) {
+                const voltage<int16_t, micro> uv = voltage<int16_t, milli>(c);
+                (void)uv;
+            }
+            const auto* c = find(1, 1000, 1, 1000000, 15);
+            ASSERT_NE(nullptr, c);
+            EXPECT_EQ(3u, c->conversions);
+            EXPECT_EQ(1u, c->overflow);
+            EXPECT_EQ(2u, c->near_overflow);
+        }
+
+        TEST(Instrument, PrintsTable) {
+            instrument::reset();
+            volatile int32_t count = 1500;
+            const time<int32_t> s = time<int32_t, milli>(count);
+            EXPECT_EQ(1, s.count());
+
+            std::stringstream ss;
+            instrument::print(ss);
+            const std::string table = ss.str();
+            EXPECT_NE(std::string::npos, table.find("conversions"));
+            EXPECT_NE(std::string::npos, table.find("1/1000"));
+            EXPECT_NE(std::string::npos, table.find("int32"));
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,148 @@
+#include "ctd/linalg.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        using namespace ctd::unit_literals;
+        using accel = quantity<int16_t, units::acceleration, ratio<1, 1000>>;
+        using q15 = quantity<int16_t, units::unity, ratio<1, 32768>>;
+
+        mat3<q15> rotation_z(double angle) {
+            const auto q = [](double v) { return q15(static_cast<int16_t>(std::lround(v * 32767))); };
+            const double c = std::cos(angle);
+            const double s = std::sin(angle);
+            return mat3<q15>({ q(c), q(-s), q(0) }, { q(s), q(c), q(0) }, { q(0), q(0), q(1) });
+        }
+
+        TEST(Vec3, Arithmetic) {
+            constexpr vec3<accel> a(accel(1), accel(2), accel(3));
+            constexpr vec3<accel> b(accel(10), accel(20), accel(30));
+            static_assert(a + b == vec3<accel>(accel(11), accel(22), accel(33)), "");
+            static_assert(b - a == vec3<accel>(accel(9), accel(18), accel(27)), "");
+            static_assert(-a == vec3<accel>(accel(-1), accel(-2), accel(-3)), "");
+            static_assert(a * 2 == vec3<accel>(accel(2), accel(4), accel(6)), "");
+            static_assert(b / 10 == a, "");
+            static_assert(a[2] == accel(3), "");
+        }
+
+        TEST(Vec3, ConvertsScaleOfWholeVector) {
+            const vec3<accel> a(accel(1500), accel(-2000), accel(0));
+            const vec3<quantity<int32_t, units::acceleration, ratio<1, 1000000>>> b = a;
+            EXPECT_EQ(1500000, b.x().count());
+            EXPECT_EQ(-2000000, b.y().count());
+        }
+
+        TEST(Vec3, DotPropagatesUnits) {
+            const vec3<length<int16_t, milli>> a(1_mm, 2_mm, 3_mm);
+            const vec3<length<int16_t, milli>> b(4_mm, 5_mm, 6_mm);
+            const auto d = dot(a, b);
+            static_assert(is_same_v<units::area, decltype(d)::units>, "");
+            static_assert(is_same_v<ratio<1, 1000000>, decltype(d)::scale>, "");
+            EXPECT_EQ(32, d.count());
+
+            // Three products of full scale int16 values don't fit in 32 bits.
+            const vec3<accel> m(accel(INT16_MIN), accel(INT16_MIN), accel(INT16_MIN));
+            EXPECT_EQ(3 * int64_t(INT16_MIN) * INT16_MIN, dot(m, m).count());
+        }
+
+        TEST(Vec3, Cross) {
+            using len = length<int16_t, milli>;
+            using force_n = force<int16_t>;
+            const vec3<len> r(len(100), len(0), len(0));
+            const vec3<force_n> f(force_n(0), force_n(5), force_n(0));
+            const auto torque = cross(r, f);
+            static_assert(is_same_v<units::joule, decltype(torque)::units>, "");
+            EXPECT_EQ(0, torque.x().count());
+            EXPECT_EQ(0, torque.y().count());
+            EXPECT_EQ(500, torque.z().count());
+        }
+
+        TEST(Vec3, Norm) {
+            const vec3<accel> a(accel(3000), accel(4000), accel(0));
+            const accel n = norm(a);
+            EXPECT_EQ(5000, n.count());
+
+            const vec3<length<float>> f(length<float>(1), length<float>(2), length<float>(2));
+            EXPECT_FLOAT_EQ(3.0f, norm(f).count());
+        }
+
+        TEST(Mat3, Products) {
+            using m = quantity<int16_t, units::unity, ratio<1>>;
+            const mat3<m> a({ m(1), m(2), m(3) }, { m(4), m(5), m(6) }, { m(7), m(8), m(9) });
+            const vec3<accel> v(accel(1), accel(0), accel(-1));
+            const auto av = a * v;
+            static_assert(is_same_v<units::acceleration, decltype(av)::units>, "");
+            EXPECT_EQ(-2, av.x().count());
+            EXPECT_EQ(-2, av.y().count());
+            EXPECT_EQ(-2, av.z().count());
+
+            const auto aa = a * a.transpose();
+            EXPECT_EQ(14, aa(0, 0).count());
+            EXPECT_EQ(32, aa(0, 1).count());
+            EXPECT_EQ(194, aa(2, 2).count());
+        }
+
+        TEST(Rotate, QuarterTurn) {
+            const auto r = rotation_z(3.14159265358979 / 2);
+            const vec3<accel> v(accel(1000), accel(0), accel(9810));
+            const vec3<accel> w = rotate(r, v);
+            EXPECT_EQ(0, w.x().count());
+            EXPECT_EQ(1000, w.y().count());
+            EXPECT_EQ(9810, w.z().count());
+        }
+
+        TEST(Rotate, Saturates) {
+            const auto r = rotation_z(3.14159265358979 / 4);
+            const vec3<accel> v(accel(30000), accel(-30000), accel(0));
+            EXPECT_EQ(INT16_MAX, rotate(r, v).x().count());
+        }
+
+        TEST(Rotate, BatchMatchesSingle) {
+            std::mt19937 rng(5);
+            const auto r = rotation_z(0.3);
+            for (size_t n : { 0, 1, 2, 3, 4, 5, 100, 101 }) {
+                std::vector<vec3<accel>> in(n);
+                for (auto& v : in) {
+                    const auto c = [&] { return accel(static_cast<int16_t>(rng())); };
+                    v = vec3<accel>(c(), c(), c());
+                }
+                std::vector<vec3<accel>> out(n);
+                rotate(r, in.data(), out.data(), n);
+                for (size_t i = 0; i < n; ++i) {
+                    ASSERT_EQ(rotate(r, in[i]), out[i]) << "n = " << n << ", i = " << i;
+                }
+
+                // In place.
+                rotate(r, in.data(), in.data(), n);
+                EXPECT_EQ(out, in);
+            }
+        }
+
+        TEST(Rotate, BatchFloat) {
+            using af = quantity<float, units::acceleration, ratio<1>>;
+            using mf = quantity<float, units::unity, ratio<1>>;
+            const float c = std::cos(0.3f);
+            const float s = std::sin(0.3f);
+            const mat3<mf> r({ mf(c), mf(-s), mf(0) }, { mf(s), mf(c), mf(0) }, { mf(0), mf(0), mf(1) });
+            std::vector<vec3<af>> in;
+            for (int i = 0; i < 9; ++i) {
+                in.push_back(vec3<af>(af(float(i)), af(float(2 * i)), af(-1.5f)));
+            }
+            std::vector<vec3<af>> out(in.size());
+            rotate(r, in.data(), out.data(), in.size());
+            for (size_t i = 0; i < in.size(); ++i) {
+                const auto e = rotate(r, in[i]);
+                EXPECT_FLOAT_EQ(e.x().count(), out[i].x().count());
+                EXPECT_FLOAT_EQ(e.y().count(), out[i].y().count());
+                EXPECT_FLOAT_EQ(e.z().count(), out[i].z().count());
+            }
+        }
+    }  // namespace
+}  // namespace ctd
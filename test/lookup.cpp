@@ -0,0 +1,136 @@
+#include "ctd/lookup.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cmath>
+
+namespace ctd {
+    namespace {
+        // Resistance of an NTC thermistor in ohms, every 5 degrees Celsius from -40 to 80.
+        constexpr int32_t ntc[] = { 332094, 239900, 175200, 129287, 96358, 72500, 55046, 42157, 32554, 25339, 19872,
+            15698, 12488, 10000, 8059, 6535, 5330, 4372, 3605, 2989, 2490, 2084, 1753, 1481, 1256 };
+        constexpr size_t ntc_size = sizeof(ntc) / sizeof(ntc[0]);
+
+        // Piecewise linear interpolation in double, for reference.
+        double interpolate(const double* xs, const int32_t* ys, size_t n, double x) {
+            if (x <= xs[0]) {
+                return ys[0];
+            }
+            for (size_t i = 0; i + 1 < n; ++i) {
+                if (x < xs[i + 1]) {
+                    return ys[i] + (ys[i + 1] - ys[i]) * (x - xs[i]) / (xs[i + 1] - xs[i]);
+                }
+            }
+            return ys[n - 1];
+        }
+
+        using celsius = temperature<int16_t, deci>;
+        using ohms = resistance<int32_t>;
+        using ntc_table = uniform_interpolation_table<celsius, ohms, ntc_size, ratio<-40>, ratio<5>>;
+        constexpr ntc_table uniform_ntc(ntc);
+
+        TEST(UniformInterpolationTable, GridPoints) {
+            static_assert(uniform_ntc(celsius(-400)).count() == 332094, "");
+            static_assert(uniform_ntc(celsius(250)).count() == 10000, "");
+            for (size_t i = 0; i < ntc_size; ++i) {
+                EXPECT_EQ(ntc[i], uniform_ntc(celsius(static_cast<int16_t>(-400 + 50 * int(i)))).count());
+            }
+        }
+
+        TEST(UniformInterpolationTable, Clamps) {
+            EXPECT_EQ(332094, uniform_ntc(celsius(-401)).count());
+            EXPECT_EQ(332094, uniform_ntc(celsius(INT16_MIN)).count());
+            EXPECT_EQ(1256, uniform_ntc(celsius(801)).count());
+            EXPECT_EQ(1256, uniform_ntc(celsius(INT16_MAX)).count());
+        }
+
+        TEST(UniformInterpolationTable, MatchesReference) {
+            double xs[ntc_size];
+            for (size_t i = 0; i < ntc_size; ++i) {
+                xs[i] = -400.0 + 50.0 * double(i);
+            }
+            for (int t = INT16_MIN; t <= INT16_MAX; ++t) {
+                const double expected = interpolate(xs, ntc, ntc_size, t);
+                ASSERT_NEAR(expected, uniform_ntc(celsius(static_cast<int16_t>(t))).count(), 0.5 + 1e-6) << t;
+            }
+        }
+
+        TEST(UniformInterpolationTable, FractionalStep) {
+            // Every 2.5 mm from 1 mm, the step isn't a whole number of counts of the input.
+            using input = length<int16_t, milli>;
+            using output = voltage<int16_t, milli>;
+            constexpr uniform_interpolation_table<input, output, 4, ratio<1, 1000>, ratio<5, 2000>> table(
+                { 0, 1000, 3000, -2000 });
+            EXPECT_EQ(0, table(input(1)).count());
+            EXPECT_EQ(400, table(input(2)).count());
+            EXPECT_EQ(800, table(input(3)).count());
+            EXPECT_EQ(3000, table(input(6)).count());
+            EXPECT_EQ(1000, table(input(7)).count());
+            EXPECT_EQ(-2000, table(input(9)).count());
+        }
+
+        TEST(InterpolationTable, MatchesUniform) {
+            int16_t xs[ntc_size];
+            for (size_t i = 0; i < ntc_size; ++i) {
+                xs[i] = static_cast<int16_t>(-400 + 50 * int(i));
+            }
+            const interpolation_table<celsius, ohms, ntc_size> table(xs, ntc);
+            for (int t = -500; t <= 900; ++t) {
+                const celsius c(static_cast<int16_t>(t));
+                ASSERT_NEAR(uniform_ntc(c).count(), table(c).count(), 1.0) << t;
+            }
+        }
+
+        TEST(InterpolationTable, NonUniform) {
+            // Open circuit voltage of a Li-ion cell against the state of charge in percent.
+            using soc = quantity<int8_t, units::unity, centi>;
+            using mv = voltage<int16_t, milli>;
+            constexpr int8_t charge[] = { 0, 5, 10, 20, 50, 80, 90, 100 };
+            constexpr int16_t ocv[] = { 3000, 3450, 3600, 3700, 3800, 3950, 4050, 4200 };
+            constexpr interpolation_table<soc, mv, 8> table(charge, ocv);
+            static_assert(table(soc(int8_t(35))).count() == 3750, "");
+
+            double xs[8];
+            int32_t ys[8];
+            for (size_t i = 0; i < 8; ++i) {
+                xs[i] = charge[i];
+                ys[i] = ocv[i];
+            }
+            for (int c = INT8_MIN; c <= INT8_MAX; ++c) {
+                const double expected = interpolate(xs, ys, 8, c);
+                ASSERT_NEAR(expected, table(soc(static_cast<int8_t>(c))).count(), 0.5 + 1e-6) << c;
+            }
+        }
+
+        TEST(InterpolationTable, WideValues) {
+            using input = length<int32_t, micro>;
+            using output = force<int64_t, micro>;
+            constexpr int32_t xs[] = { -1000000000, 0, 7, 1000000000 };
+            constexpr int64_t ys[] = { 4000000000000, 0, 70000000000, -1 };
+            constexpr interpolation_table<input, output, 4> table(xs, ys);
+            EXPECT_EQ(2000000000000, table(input(-500000000)).count());
+            EXPECT_EQ(30000000000, table(input(3)).count());
+            EXPECT_NEAR(35000000000.0, double(table(input(500000003)).count()), 1e3);
+        }
+
+        TEST(InterpolationTable, RejectsNonIncreasingAtRunTime) {
+            using input = length<int16_t, milli>;
+            using output = voltage<int16_t, milli>;
+            // Not known during compilation, so the check can't fail to compile.
+            volatile int16_t end = 10;
+            const int16_t xs[] = { 0, end, end };
+            const int16_t ys[] = { 100, 200, 300 };
+            const interpolation_table<input, output, 3> table(xs, ys);
+            EXPECT_FALSE(table.valid());
+            for (int16_t x : { -5, 0, 5, 10, 15 }) {
+                EXPECT_EQ(100, table(input(x)).count()) << x;
+            }
+
+            constexpr int16_t increasing[] = { 0, 10, 20 };
+            constexpr interpolation_table<input, output, 3> good(increasing, ys);
+            static_assert(good.valid(), "");
+        }
+    }  // namespace
+}  // namespace ctd
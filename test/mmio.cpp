@@ -0,0 +1,55 @@
+#include "ctd/mmio.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+namespace ctd {
+    namespace {
+        // A 12 bit ADC with a 3.3 V reference.
+        using adc_lsb = ratio<3300, 4096 * 1000>;
+
+        TEST(MmioQuantity, LoadsWithUnitsAndScale) {
+            volatile uint16_t reg = 2048;
+            const mmio_quantity<dynamic_address, uint16_t, units::volt, adc_lsb> adc(&reg);
+            const voltage<int32_t, milli> v = adc.load();
+            EXPECT_EQ(1650, v.count());
+            reg = 4095;
+            const voltage<int32_t, milli> full = adc;
+            EXPECT_EQ(3299, full.count());
+            EXPECT_EQ(&reg, adc.address());
+        }
+
+        TEST(MmioQuantity, StoresConvertedQuantities) {
+            volatile uint32_t reg = 0;
+            const mmio_quantity<dynamic_address, uint32_t, units::second, micro> compare(&reg);
+            compare = time<uint32_t, milli>(25);
+            EXPECT_EQ(25000u, reg);
+            compare.store(500);
+            EXPECT_EQ(500u, reg);
+        }
+
+        TEST(MmioQuantity, BitFields) {
+            volatile uint32_t reg = 0xA5000FFFu;
+            // A status register with a 12 bit conversion result in bits 12 to 23.
+            const mmio_quantity<dynamic_address, uint32_t, units::volt, adc_lsb, 12, 12> result(&reg);
+            static_assert(decltype(result)::is_field, "");
+            EXPECT_EQ(0u, result.load().count());
+            result.store(0xABC);
+            EXPECT_EQ(0xA5ABCFFFu, reg);
+            EXPECT_EQ(0xABCu, result.load().count());
+            result.store(0x1FFF);
+            EXPECT_EQ(0xA5FFFFFFu, reg);
+        }
+
+        TEST(MmioQuantity, SignedFields) {
+            volatile int16_t reg = 0;
+            const mmio_quantity<dynamic_address, int16_t, units::kelvin, ratio<1, 16>, 4, 10> temperature(&reg);
+            temperature.store(-3);
+            EXPECT_EQ(-3, temperature.load().count());
+            EXPECT_EQ(int16_t(0x3FD0), reg);
+            temperature.store(511);
+            EXPECT_EQ(511, temperature.load().count());
+        }
+    }  // namespace
+}  // namespace ctd
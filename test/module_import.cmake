@@ -0,0 +1,29 @@
+# Builds src/ctd.cppm and test/module_import.cpp with GCC's -fmodules-ts and runs the importer, for when CMake can't
+# build modules itself. Run with cmake -P and these variables:
+#   CTD_CXX      the compiler
+#   CTD_SOURCE   the source directory
+#   CTD_WORK     an empty directory for the objects and the module cache
+#   CTD_HAS_STL  whether to build the module with HAS_STL defined
+# Without HAS_STL the headers expect the target toolchain to provide cstdint.hpp, which is written to CTD_WORK.
+
+file(REMOVE_RECURSE ${CTD_WORK})
+file(MAKE_DIRECTORY ${CTD_WORK})
+
+set(flags -std=c++20 -fmodules-ts -I${CTD_SOURCE}/include)
+if(CTD_HAS_STL)
+	list(APPEND flags -DHAS_STL=1)
+else()
+	file(WRITE ${CTD_WORK}/cstdint.hpp "#include <stdint.h>\n")
+	list(APPEND flags -I${CTD_WORK})
+endif()
+
+function(run_step)
+	execute_process(COMMAND ${ARGN} WORKING_DIRECTORY ${CTD_WORK} RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "'${ARGN}' failed: ${result}")
+	endif()
+endfunction()
+
+run_step(${CTD_CXX} ${flags} -x c++ -c ${CTD_SOURCE}/src/ctd.cppm -o ctd.o)
+run_step(${CTD_CXX} ${flags} ${CTD_SOURCE}/test/module_import.cpp ctd.o -o module_import)
+run_step(${CTD_WORK}/module_import)
@@ -0,0 +1,30 @@
+// Imports the ctd module instead of including the headers. test/module_import.cmake compiles src/ctd.cppm and this
+// file with GCC's -fmodules-ts and runs the result, which fails by returning a non-zero exit code.
+import ctd;
+
+using namespace ctd::unit_literals;
+
+int main() {
+    ctd::voltage<int, ctd::milli> v(5);
+    ctd::voltage<int, ctd::milli> w = v + 3_mV;
+    if (w.count() != 8 || !(w > v) || w == v) {
+        return 1;
+    }
+
+    ctd::resistance<int, ctd::kilo> r(2);
+    ctd::current<int, ctd::micro> i = w / r;
+    if (i.count() != 4) {
+        return 2;
+    }
+
+    static_assert(ctd::ratio_equal<ctd::ratio_multiply<ctd::milli, ctd::kilo>, ctd::ratio<1>>::value);
+    if (ctd::sqrt(ctd::pow<2>(ctd::length<int>(3))).count() != 3) {
+        return 3;
+    }
+
+    ctd::bounded<ctd::voltage<int, ctd::milli>, 0, 100> b(8);
+    if (!(b + b == ctd::bounded<ctd::voltage<int, ctd::milli>, 0, 200>(16))) {
+        return 4;
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "ctd/packed_quantity_array.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cstdlib>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        template <typename A>
+        void fill(A& a, std::vector<typename A::quantity_type>& expected) {
+            std::srand(7);
+            expected.clear();
+            for (size_t i = 0; i < A::size(); ++i) {
+                const auto v = static_cast<typename A::value_type>(std::rand());
+                auto q = typename A::quantity_type(v);
+                a.set(i, q);
+                expected.push_back(a.get(i));
+            }
+        }
+
+        template <typename A>
+        void check_round_trip() {
+            A a;
+            std::vector<typename A::quantity_type> expected;
+            fill(a, expected);
+            for (size_t i = 0; i < A::size(); ++i) {
+                ASSERT_EQ(expected[i].count(), a.get(i).count()) << i;
+            }
+            // Every start and length, so both the sequential and the vector paths are covered.
+            std::vector<typename A::quantity_type> out(A::size());
+            for (size_t first = 0; first < 17; ++first) {
+                for (size_t n : { size_t(0), size_t(1), size_t(9), A::size() - first }) {
+                    a.unpack(first, n, out.data());
+                    for (size_t i = 0; i < n; ++i) {
+                        ASSERT_EQ(expected[first + i].count(), out[i].count()) << first << " " << i;
+                    }
+                }
+            }
+        }
+
+        TEST(PackedQuantityArray, ExactStorage) {
+            static_assert(sizeof(packed_quantity_array<12, units::volt, milli, 100>) == 150, "");
+            static_assert(sizeof(packed_quantity_array<10, units::volt, milli, 101>) == 127, "");
+            static_assert(is_same_v<packed_quantity_array<14, units::volt, milli, 8>::value_type, uint16_t>, "");
+            static_assert(is_same_v<packed_quantity_array<14, units::volt, milli, 8, true>::value_type, int16_t>, "");
+            static_assert(is_same_v<packed_quantity_array<3, units::volt, milli, 8>::value_type, uint8_t>, "");
+            static_assert(is_same_v<packed_quantity_array<20, units::volt, milli, 8>::value_type, uint32_t>, "");
+        }
+
+        TEST(PackedQuantityArray, SetKeepsNeighbours) {
+            packed_quantity_array<12, units::volt, milli, 5> a;
+            for (size_t i = 0; i < a.size(); ++i) {
+                a.set(i, 0xFFF);
+            }
+            a.set(2, 0x123);
+            EXPECT_EQ(0xFFF, a[1].count());
+            EXPECT_EQ(0x123, a[2].count());
+            EXPECT_EQ(0xFFF, a[3].count());
+            a.set(2, 0x1ABC);
+            EXPECT_EQ(0xABC, a[2].count());
+            EXPECT_EQ(0xFFF, a[3].count());
+        }
+
+        TEST(PackedQuantityArray, Signed) {
+            packed_quantity_array<10, units::ampere, micro, 4, true> a;
+            a.set(0, -512);
+            a.set(1, 511);
+            a.set(2, -1);
+            EXPECT_EQ(-512, a[0].count());
+            EXPECT_EQ(511, a[1].count());
+            EXPECT_EQ(-1, a[2].count());
+            EXPECT_EQ(0, a[3].count());
+        }
+
+        TEST(PackedQuantityArray, RoundTrip) {
+            check_round_trip<packed_quantity_array<1, units::volt, milli, 100>>();
+            check_round_trip<packed_quantity_array<7, units::volt, milli, 100, true>>();
+            check_round_trip<packed_quantity_array<10, units::volt, milli, 203>>();
+            check_round_trip<packed_quantity_array<12, units::volt, milli, 200>>();
+            check_round_trip<packed_quantity_array<12, units::volt, milli, 200, true>>();
+            check_round_trip<packed_quantity_array<14, units::volt, milli, 77>>();
+            check_round_trip<packed_quantity_array<16, units::volt, milli, 64>>();
+            check_round_trip<packed_quantity_array<16, units::volt, milli, 64, true>>();
+            check_round_trip<packed_quantity_array<24, units::volt, milli, 50, true>>();
+            check_round_trip<packed_quantity_array<32, units::volt, milli, 50>>();
+        }
+
+        TEST(PackedQuantityArray, Constexpr) {
+            constexpr auto a = [] {
+                packed_quantity_array<12, units::volt, milli, 3> a;
+                a.set(1, 4000);
+                return a;
+            }();
+            static_assert(a[1].count() == 4000, "");
+            static_assert(a[0].count() == 0, "");
+            const voltage<int32_t, micro> v = a[1];
+            EXPECT_EQ(4000000, v.count());
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,124 @@
+#include "ctd/parallel.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <random>
+#include <vector>
+
+namespace ctd {
+    namespace {
+        using millivolts = voltage<int16_t, milli>;
+
+        std::vector<millivolts> readings(size_t n) {
+            std::mt19937 rng(3);
+            std::vector<millivolts> v(n);
+            for (auto& x : v) {
+                x = millivolts(static_cast<int16_t>(rng()));
+            }
+            return v;
+        }
+
+        TEST(Parallel, ThreadPoolRunsEveryIndexOnce) {
+            for (unsigned threads : { 1u, 2u, 5u }) {
+                parallel::thread_pool pool(threads);
+                EXPECT_EQ(threads, pool.size());
+                std::vector<std::atomic<int>> calls(1000);
+                for (int job = 0; job < 10; ++job) {
+                    pool.run(calls.size(), [&](size_t i) { calls[i].fetch_add(1); });
+                }
+                for (const auto& c : calls) {
+                    EXPECT_EQ(10, c.load());
+                }
+                pool.run(0, [](size_t) { FAIL(); });
+            }
+        }
+
+        TEST(Parallel, ReduceMatchesSerialSum) {
+            // Several chunks and a partial one at the end, and enough large readings to overflow 32 bits.
+            auto v = readings(5 * 65536 + 123);
+            std::fill(v.begin(), v.begin() + 70000, millivolts(INT16_MAX));
+            int64_t expected = 0;
+            for (const auto& x : v) {
+                expected += x.count();
+            }
+            for (unsigned threads : { 1u, 3u, 8u }) {
+                parallel::thread_pool pool(threads);
+                const auto sum = parallel::reduce(v.data(), v.data() + v.size(), pool);
+                static_assert(is_same_v<decltype(sum), const voltage<int64_t, milli>>, "");
+                EXPECT_EQ(expected, sum.count());
+            }
+            EXPECT_EQ(0, parallel::reduce(v.data(), v.data()).count());
+        }
+
+        TEST(Parallel, ReduceIntoDestinationScale) {
+            const auto v = readings(3 * 65536);
+            int64_t expected = 0;
+            for (const auto& x : v) {
+                expected += x.count();
+            }
+            const auto volts = parallel::reduce<voltage<double>>(v.data(), v.data() + v.size());
+            EXPECT_NEAR(expected / 1000.0, volts.count(), 1e-6);
+            const auto micro_volts = parallel::reduce<voltage<int64_t, micro>>(v.data(), v.data() + v.size());
+            EXPECT_EQ(expected * 1000, micro_volts.count());
+        }
+
+        TEST(Parallel, ReduceFloatIsIndependentOfThreads) {
+            std::vector<voltage<float>> v(4 * 65536 + 7);
+            std::mt19937 rng(5);
+            std::uniform_real_distribution<float> dist(-1, 1);
+            for (auto& x : v) {
+                x = dist(rng);
+            }
+            parallel::thread_pool one(1);
+            parallel::thread_pool four(4);
+            const auto a = parallel::reduce(v.data(), v.data() + v.size(), one);
+            const auto b = parallel::reduce(v.data(), v.data() + v.size(), four);
+            EXPECT_EQ(a.count(), b.count());
+        }
+
+        TEST(Parallel, TransformRescales) {
+            const auto v = readings(2 * 65536 + 1);
+            std::vector<voltage<int32_t, micro>> uv(v.size());
+            parallel::transform(v.data(), v.data() + v.size(), uv.data());
+            std::vector<voltage<int16_t, centi>> cv(v.size());
+            parallel::transform(v.data(), v.data() + v.size(), cv.data());
+            for (size_t i = 0; i < v.size(); ++i) {
+                ASSERT_EQ(v[i].count() * 1000, uv[i].count());
+                const int16_t rounded = static_cast<int16_t>(v[i].count() < 0 ? (v[i].count() - 5) / 10
+                    : (v[i].count() + 5) / 10);
+                ASSERT_EQ(rounded, cv[i].count()) << v[i].count();
+            }
+        }
+
+        TEST(Parallel, TransformWithFunction) {
+            const auto v = readings(100000);
+            std::vector<voltage<double>> out(v.size());
+            parallel::transform(v.data(), v.data() + v.size(), out.data(),
+                [](millivolts x) { return voltage<int32_t, milli>(2 * x.count()); });
+            for (size_t i = 0; i < v.size(); ++i) {
+                ASSERT_DOUBLE_EQ(v[i].count() * 0.002, out[i].count());
+            }
+        }
+
+        TEST(Parallel, Minmax) {
+            auto v = readings(3 * 65536 + 5);
+            for (auto& x : v) {
+                x = millivolts(static_cast<int16_t>(x.count() / 2));
+            }
+            v[70000] = millivolts(-20000);
+            v[v.size() - 1] = millivolts(20000);
+            for (unsigned threads : { 1u, 4u }) {
+                parallel::thread_pool pool(threads);
+                const auto [lo, hi] = parallel::minmax(v.data(), v.data() + v.size(), pool);
+                EXPECT_EQ(-20000, lo.count());
+                EXPECT_EQ(20000, hi.count());
+            }
+            const millivolts single(5);
+            const auto [lo, hi] = parallel::minmax(&single, &single + 1);
+            EXPECT_EQ(5, lo.count());
+            EXPECT_EQ(5, hi.count());
+        }
+    }  // namespace
+}  // namespace ctd
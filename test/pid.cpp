@@ -0,0 +1,101 @@
+#include "ctd/pid.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+namespace ctd {
+    namespace {
+        using error_mv = voltage<int16_t, milli>;
+        using output_mv = voltage<int16_t, milli>;
+        using period_1ms = milli;
+
+        TEST(PidController, Proportional) {
+            pid_controller<error_mv, output_mv, period_1ms, ratio<2>, ratio<0>> pid(output_mv(-5000), output_mv(5000));
+            EXPECT_EQ(200, pid.update(error_mv(100)).count());
+            EXPECT_EQ(-2, pid.update(error_mv(-1)).count());
+            EXPECT_EQ(5000, pid.update(error_mv(3000)).count());
+        }
+
+        TEST(PidController, FoldsScales) {
+            // 10 mA per V, from an error in mV to an output in uA.
+            using error_type = voltage<int16_t, milli>;
+            using output_type = current<int32_t, micro>;
+            pid_controller<error_type, output_type, period_1ms, ratio<1, 100>, ratio<0>> pid(output_type(-1000000),
+                output_type(1000000));
+            EXPECT_EQ(10000, pid.update(error_type(1000)).count());
+            EXPECT_EQ(-330, pid.update(error_type(-33)).count());
+        }
+
+        TEST(PidController, IntegratesBelowOneLsb) {
+            // 1 mV * 1/s * 1 ms is a thousandth of an output LSB per update.
+            pid_controller<error_mv, output_mv, period_1ms, ratio<0>, ratio<1>> pid(output_mv(-5000), output_mv(5000));
+            output_mv out = 0;
+            for (int i = 0; i < 1499; ++i) {
+                out = pid.update(error_mv(1));
+            }
+            EXPECT_EQ(1, out.count());
+            for (int i = 0; i < 1000; ++i) {
+                out = pid.update(error_mv(1));
+            }
+            EXPECT_EQ(2, out.count());
+            EXPECT_EQ(2, pid.integral().count());
+        }
+
+        TEST(PidController, Integral) {
+            // 100 mV * 10/s * 1 ms is 1 mV per update.
+            pid_controller<error_mv, output_mv, period_1ms, ratio<0>, ratio<10>> pid(output_mv(-5000), output_mv(5000));
+            for (int i = 1; i <= 50; ++i) {
+                EXPECT_EQ(i, pid.update(error_mv(100)).count());
+            }
+            pid.reset(output_mv(-7));
+            EXPECT_EQ(-6, pid.update(error_mv(100)).count());
+        }
+
+        TEST(PidController, AntiWindup) {
+            pid_controller<error_mv, output_mv, period_1ms, ratio<1>, ratio<100>> pid(output_mv(-100), output_mv(100));
+            for (int i = 0; i < 10000; ++i) {
+                EXPECT_EQ(100, pid.update(error_mv(1000)).count());
+            }
+            // Without anti-windup the integral would be 10^6 mV and take as long to unwind.
+            EXPECT_LE(pid.integral().count(), 100);
+            EXPECT_GT(100, pid.update(error_mv(-10)).count());
+        }
+
+        TEST(PidController, IntegratorSaturatesAtTheLimits) {
+            // Huge errors for a long time, the integrator must not overflow.
+            using error_type = voltage<int32_t, micro>;
+            using output_type = voltage<int32_t, micro>;
+            pid_controller<error_type, output_type, period_1ms, ratio<0>, ratio<1000>> pid(output_type(INT32_MIN),
+                output_type(INT32_MAX));
+            for (int i = 0; i < 100; ++i) {
+                pid.update(error_type(INT32_MAX));
+            }
+            EXPECT_EQ(INT32_MAX, pid.integral().count());
+            for (int i = 0; i < 100; ++i) {
+                pid.update(error_type(INT32_MIN));
+            }
+            EXPECT_EQ(INT32_MIN, pid.integral().count());
+        }
+
+        TEST(PidController, Derivative) {
+            // 1 mV/mV * 1 ms gives an output equal to the change of the error per update.
+            pid_controller<error_mv, output_mv, period_1ms, ratio<0>, ratio<0>, milli> pid(output_mv(-5000),
+                output_mv(5000));
+            EXPECT_EQ(0, pid.update(error_mv(100)).count());
+            EXPECT_EQ(50, pid.update(error_mv(150)).count());
+            EXPECT_EQ(0, pid.update(error_mv(150)).count());
+            // The difference of two int16_t errors doesn't fit int16_t.
+            EXPECT_EQ(-5000, pid.update(error_mv(-32000)).count());
+        }
+
+        TEST(PidController, FloatingPoint) {
+            using error_type = voltage<float>;
+            using output_type = voltage<float>;
+            pid_controller<error_type, output_type, period_1ms, ratio<2>, ratio<10>, milli> pid(output_type(-5),
+                output_type(5));
+            EXPECT_FLOAT_EQ(2 * 0.5f + 0.005f, pid.update(error_type(0.5f)).count());
+            EXPECT_FLOAT_EQ(2 * 0.25f + 0.0075f - 0.25f, pid.update(error_type(0.25f)).count());
+        }
+    }  // namespace
+}  // namespace ctd
@@ -0,0 +1,61 @@
+#include "ctd/prefix.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <string>
+
+namespace ctd {
+    namespace {
+        using reading = voltage<int16_t, milli>;
+        using display = prefix_converter<reading, micro, milli, ratio<1>, kilo>;
+
+        TEST(PrefixConverter, ConvertsByIndex) {
+            static_assert(display::size() == 4, "");
+            const reading r = 12345;
+            EXPECT_EQ(12345000, display::convert(r, 0));
+            EXPECT_EQ(12345, display::convert(r, 1));
+            EXPECT_EQ(12, display::convert(r, 2));
+            EXPECT_EQ(0, display::convert(r, 3));
+        }
+
+        TEST(PrefixConverter, RoundsToNearest) {
+            EXPECT_EQ(13, display::convert(reading(12500), 2));
+            EXPECT_EQ(-13, display::convert(reading(-12500), 2));
+            EXPECT_EQ(12, display::convert(reading(12499), 2));
+        }
+
+        TEST(PrefixConverter, MatchesRatioConvert) {
+            for (int v = -32768; v <= 32767; v += 37) {
+                const reading r = static_cast<int16_t>(v);
+                EXPECT_EQ((ratio_convert<ratio<1>, milli, intmax_t, float_round_style::round_to_nearest>(v)),
+                    display::convert(r, 2));
+            }
+        }
+
+        TEST(PrefixConverter, Symbols) {
+            EXPECT_EQ(std::string("u"), display::symbol(0));
+            EXPECT_EQ(std::string("m"), display::symbol(1));
+            EXPECT_EQ(std::string(""), display::symbol(2));
+            EXPECT_EQ(std::string("k"), display::symbol(3));
+            using custom = prefix_converter<time<int32_t>, ratio<60>, ratio<3600>>;
+            EXPECT_EQ(nullptr, custom::symbol(0));
+            EXPECT_EQ(2, custom::convert(time<int32_t>(7199), 1));
+        }
+
+        TEST(PrefixConverter, Autorange) {
+            using range = engineering_prefixes<current<int32_t, micro>>;
+            EXPECT_EQ(0u, range::autorange(current<int32_t, micro>(999)));
+            EXPECT_EQ(1u, range::autorange(current<int32_t, micro>(1000)));
+            EXPECT_EQ(2u, range::autorange(current<int32_t, micro>(-2000000)));
+            EXPECT_EQ(0u, range::autorange(current<int32_t, micro>(0)));
+        }
+
+        TEST(PrefixConverter, FloatingPoint) {
+            using fdisplay = prefix_converter<voltage<double>, milli, ratio<1>, kilo>;
+            EXPECT_DOUBLE_EQ(1500.0, fdisplay::convert(voltage<double>(1.5), 0));
+            EXPECT_DOUBLE_EQ(0.0015, fdisplay::convert(voltage<double>(1.5), 2));
+        }
+    }  // namespace
+}  // namespace ctd
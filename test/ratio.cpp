@@ -4,6 +4,8 @@
 #include <gtest/gtest.h>
 #pragma warning(pop)
 
+#include <cmath>
+
 namespace ctd {
     namespace {
         TEST(RatioScale, FloatingPoint) {
@@ -74,5 +76,103 @@ namespace ctd {
             EXPECT_EQ(317, (ratio_convert<ratio<99, 100>, ratio<49, 50>, int, float_round_style::round_toward_neg_infinity>(321)));
         }
 
+        TEST(RatioRoot, PerfectSquare) {
+            using root = ratio_root<ratio<4, 9>, 2>;
+            EXPECT_EQ(1, root::radicand);
+            EXPECT_TRUE((ratio_equal<ratio<2, 3>, root::type>::value));
+
+            using micro_root = ratio_root<micro, 2>;
+            EXPECT_EQ(1, micro_root::radicand);
+            EXPECT_TRUE((ratio_equal<milli, micro_root::type>::value));
+        }
+
+        TEST(RatioRoot, SplitsSquareFactors) {
+            // sqrt(x * 12/5) = sqrt(x * 3 * 5) * 2/5
+            using root = ratio_root<ratio<12, 5>, 2>;
+            EXPECT_EQ(15, root::radicand);
+            EXPECT_TRUE((ratio_equal<ratio<2, 5>, root::type>::value));
+
+            // sqrt(x / 1000) = sqrt(x * 10) / 100
+            using milli_root = ratio_root<milli, 2>;
+            EXPECT_EQ(10, milli_root::radicand);
+            EXPECT_TRUE((ratio_equal<ratio<1, 100>, milli_root::type>::value));
+        }
+
+        TEST(RatioRoot, LargePrimeSquare) {
+            // 999999937 is prime, its square is too big for trial division to find.
+            using root = ratio_root<ratio<999999937LL * 999999937LL>, 2>;
+            EXPECT_EQ(1, root::radicand);
+            EXPECT_EQ(999999937, root::type::num);
+        }
+
+        TEST(RatioRoot, Cube) {
+            // cbrt(x * -16/1000) = cbrt(x * 2) * -2/10
+            using root = ratio_root<ratio<-16, 1000>, 3>;
+            EXPECT_EQ(2, root::radicand);
+            EXPECT_TRUE((ratio_equal<ratio<-1, 5>, root::type>::value));
+
+            using milli_root = ratio_root<milli, 3>;
+            EXPECT_EQ(1, milli_root::radicand);
+            EXPECT_TRUE((ratio_equal<ratio<1, 10>, milli_root::type>::value));
+        }
+
+        TEST(RatioPower, Square) {
+            EXPECT_TRUE((ratio_equal<micro, ratio_power<milli, 2>::type>::value));
+            EXPECT_TRUE((ratio_equal<ratio<1>, ratio_power<milli, 0>::type>::value));
+            EXPECT_TRUE((ratio_equal<ratio<-8, 27>, ratio_power<ratio<-2, 3>, 3>::type>::value));
+        }
+
+        TEST(RatioMultiplyShift, OneThird) {
+            using r = ratio_multiply_shift<ratio<1, 3>, 15>;
+            EXPECT_EQ(16, r::shift);
+            EXPECT_EQ(21845, r::multiplier);
+            EXPECT_EQ(100, r::apply(int32_t(300)));
+            EXPECT_EQ(-100, r::apply(int32_t(-300)));
+        }
+
+        TEST(RatioMultiplyShift, MatchesExactScaling) {
+            using r = ratio_multiply_shift<ratio<1000, 1024>>;
+            for (int64_t x = -100000; x <= 100000; x += 7) {
+                const auto exact = ratio_scale<ratio<1000, 1024>, int64_t, float_round_style::round_to_nearest>(x);
+                // Ties round up rather than away from zero.
+                EXPECT_NEAR(exact, r::apply(x), x < 0 ? 1 : 0) << x;
+            }
+            // Ratios above one get a correspondingly smaller shift.
+            using big = ratio_multiply_shift<ratio<1000000, 7>>;
+            EXPECT_EQ(142857143, big::apply(int64_t(1000)));
+        }
+
+        TEST(RatioApproximate, ExactPowerOfTwo) {
+            // 3.3 V over 4096 counts in mV per count is 825/1024, exactly.
+            using a = ratio_approximate<ratio_divide<ratio<33, 40960>, milli>, ratio<0>>;
+            static_assert(a::num == 825 && a::den == 1024 && a::shift == 10 && a::power_of_two, "");
+            static_assert(a::error::num == 0, "");
+        }
+
+        TEST(RatioApproximate, SmallestShiftWithinError) {
+            using r = ratio<99, 98>;
+            using a = ratio_approximate<r, ratio<1, 1000>>;
+            static_assert(a::power_of_two, "");
+            static_assert(ratio_less_equal<a::error, ratio<1, 1000>>::value, "");
+            // One bit less isn't good enough.
+            const double coarser = double(detail::fixed_point_round(99, 98, a::shift - 1)) / double(a::den / 2);
+            EXPECT_GT(std::abs(coarser / (99.0 / 98.0) - 1), 1e-3);
+            EXPECT_EQ(9, a::shift);
+            EXPECT_EQ(517, a::num);
+        }
+
+        TEST(RatioApproximate, Simplest) {
+            using pi = ratio<314159265, 100000000>;
+            using coarse = ratio_approximate<pi, ratio<1, 1000>, approximation_simplest>;
+            static_assert(coarse::num == 22 && coarse::den == 7, "");
+            using fine = ratio_approximate<pi, ratio<1, 1000000>, approximation_simplest>;
+            static_assert(fine::num == 355 && fine::den == 113, "");
+            static_assert(ratio_less_equal<fine::error, ratio<1, 1000000>>::value, "");
+
+            using a = ratio_approximate<ratio<99, 98>, ratio<1, 1000>, approximation_simplest>;
+            static_assert(a::num == 91 && a::den == 90, "");
+            using exact = ratio_approximate<ratio<6, 4>, ratio<0>, approximation_simplest>;
+            static_assert(exact::num == 3 && exact::den == 2, "");
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "ctd/rescale.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <cstdlib>
+
+namespace ctd {
+    namespace {
+        using fine = voltage<int16_t, micro>;
+        using coarse = voltage<int16_t, milli>;
+
+        TEST(Xorshift32, MatchesReferenceSequence) {
+            xorshift32 random;
+            EXPECT_EQ(723471715u, random());
+            EXPECT_EQ(2497366906u, random());
+        }
+
+        TEST(ErrorFeedbackConverter, SumIsExact) {
+            error_feedback_converter<coarse, fine> convert;
+            int64_t sum = 0;
+            int64_t truncated = 0;
+            for (int i = 0; i < 1000; ++i) {
+                sum += convert(fine(1234)).count();
+                truncated += coarse(fine(1234)).count();
+            }
+            EXPECT_EQ(1234, sum);
+            EXPECT_EQ(1000, truncated);
+        }
+
+        TEST(ErrorFeedbackConverter, NegativeAndVarying) {
+            error_feedback_converter<coarse, fine> convert;
+            int64_t in = 0;
+            int64_t out = 0;
+            for (int i = 0; i < 5000; ++i) {
+                const int16_t x = static_cast<int16_t>((i * 7919) % 20001 - 10000);
+                in += x;
+                out += convert(fine(x)).count();
+                ASSERT_LE(std::abs(out * 1000 - in), 1000);
+            }
+            convert.reset();
+            EXPECT_EQ(0, convert(fine(-499)).count());
+            EXPECT_EQ(-1, convert(fine(-502)).count());
+        }
+
+        TEST(ErrorFeedbackConverter, KeepsMeanThroughChain) {
+            // Three stages of / 3 in int16_t, where truncation would lose most of the signal.
+            using a = current<int16_t, ratio<1, 27>>;
+            using b = current<int16_t, ratio<1, 9>>;
+            using c = current<int16_t, ratio<1, 3>>;
+            using d = current<int16_t>;
+            error_feedback_converter<b, a> ab;
+            error_feedback_converter<c, b> bc;
+            error_feedback_converter<d, c> cd;
+            int64_t sum = 0;
+            for (int i = 0; i < 2700; ++i) {
+                sum += cd(bc(ab(a(20)))).count();
+            }
+            EXPECT_NEAR(2000, sum, 3);
+            EXPECT_EQ(0, d(c(b(a(20)))).count());
+        }
+
+        TEST(StochasticConverter, Unbiased) {
+            stochastic_converter<coarse, fine> convert;
+            int64_t sum = 0;
+            constexpr int n = 100000;
+            for (int i = 0; i < n; ++i) {
+                const int16_t y = convert(fine(-1234)).count();
+                ASSERT_TRUE(y == -1 || y == -2);
+                sum += y;
+            }
+            EXPECT_NEAR(-1.234, double(sum) / n, 0.01);
+        }
+
+        TEST(StochasticConverter, ExactConversionsAreDeterministic) {
+            stochastic_converter<fine, coarse> up;
+            EXPECT_EQ(-2000, up(coarse(-2)).count());
+            stochastic_converter<coarse, fine> down(xorshift32(1));
+            for (int i = 0; i < 100; ++i) {
+                EXPECT_EQ(3, down(fine(3000)).count());
+            }
+        }
+    }  // namespace
+}  // namespace ctd
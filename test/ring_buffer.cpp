@@ -0,0 +1,112 @@
+#include "ctd/ring_buffer.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <atomic>
+#include <thread>
+
+namespace ctd {
+    namespace {
+        using sample = voltage<int16_t, milli>;
+
+        TEST(SpscRingBuffer, StoresRawCounts) {
+            static_assert(sizeof(spsc_ring_buffer<sample, 4>) == sizeof(spsc_ring_buffer<int16_t, 4>), "");
+            static_assert(is_same_v<uint8_t, spsc_ring_buffer<sample, 128>::index_type>, "");
+            static_assert(is_same_v<uint16_t, spsc_ring_buffer<sample, 256>::index_type>, "");
+        }
+
+        TEST(SpscRingBuffer, PushPop) {
+            spsc_ring_buffer<sample, 4> rb;
+            sample out = 0;
+            EXPECT_FALSE(rb.pop(out));
+
+            for (int16_t i = 1; i <= 4; ++i) {
+                EXPECT_TRUE(rb.push(sample(i)));
+            }
+            EXPECT_FALSE(rb.push(sample(5)));
+            EXPECT_EQ(4u, rb.size());
+
+            EXPECT_TRUE(rb.pop(out));
+            EXPECT_EQ(sample(1), out);
+            EXPECT_TRUE(rb.push(sample(5)));
+            for (int16_t i = 2; i <= 5; ++i) {
+                EXPECT_TRUE(rb.pop(out));
+                EXPECT_EQ(i, out.count());
+            }
+            EXPECT_TRUE(rb.empty());
+        }
+
+        TEST(SpscRingBuffer, IndicesWrap) {
+            spsc_ring_buffer<int, 128> rb;
+            int out = 0;
+            for (int i = 0; i < 1000; ++i) {
+                ASSERT_TRUE(rb.push(i));
+                ASSERT_TRUE(rb.pop(out));
+                ASSERT_EQ(i, out);
+            }
+        }
+
+        TEST(SpscRingBuffer, Batch) {
+            spsc_ring_buffer<sample, 8> rb;
+            sample in[16];
+            for (int16_t i = 0; i < 16; ++i) {
+                in[i] = i;
+            }
+            sample out[16] = {};
+
+            EXPECT_EQ(6u, rb.push(in, 6));
+            EXPECT_EQ(4u, rb.pop(out, 4));
+            // Only 6 fit, and they wrap around the end of the storage.
+            EXPECT_EQ(6u, rb.push(in + 6, 10));
+            EXPECT_EQ(0u, rb.push(in, 1));
+            EXPECT_EQ(8u, rb.pop(out + 4, 12));
+            EXPECT_EQ(0u, rb.pop(out, 16));
+
+            for (int16_t i = 0; i < 12; ++i) {
+                EXPECT_EQ(i, out[i].count());
+            }
+        }
+
+        TEST(SpscRingBuffer, TwoThreads) {
+            constexpr int count = 200000;
+            spsc_ring_buffer<int, 64> rb;
+            // Set when the consumer stops early, so that the producer doesn't wait for room forever.
+            std::atomic<bool> failed{ false };
+
+            std::thread producer([&] {
+                int batch[7];
+                int next = 0;
+                while (next < count && !failed) {
+                    int n = 0;
+                    while (n < 7 && next + n < count) {
+                        batch[n] = next + n;
+                        ++n;
+                    }
+                    const size_t pushed = rb.push(batch, n);
+                    if (pushed == 0) {
+                        std::this_thread::yield();
+                    }
+                    next += static_cast<int>(pushed);
+                }
+            });
+
+            int expected = 0;
+            int out[5];
+            while (expected < count && !failed) {
+                size_t n = rb.pop(out, 5);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (size_t i = 0; i < n && !failed; ++i) {
+                    EXPECT_EQ(expected, out[i]);
+                    failed = out[i] != expected++;
+                }
+            }
+            producer.join();
+            EXPECT_FALSE(failed);
+            EXPECT_TRUE(rb.empty());
+        }
+    }
+}
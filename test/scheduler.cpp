@@ -0,0 +1,90 @@
+#include "ctd/clock.hpp"
+#include "ctd/scheduler.hpp"
+
+#pragma warning(push, 0)
+#include <gtest/gtest.h>
+#pragma warning(pop)
+
+#include <string>
+
+using namespace ctd::unit_literals;
+
+namespace ctd {
+    namespace {
+        struct sim_timer {
+            static inline uint16_t value = 0;
+            static uint16_t read() { return value; }
+        };
+
+        // 1 kHz timer, i.e. one tick per millisecond.
+        using clock = tick_clock<1000, sim_timer>;
+
+        std::string trace;
+
+        struct tracer {
+            char name;
+            void operator()() const { trace += name; }
+        };
+
+        TEST(PeriodicScheduler, PeriodIsResolvedAtCompileTime) {
+            constexpr periodic_scheduler<clock, 1>::period p = 250_ms;
+            static_assert(p.count().count() == 250, "");
+            constexpr periodic_scheduler<clock, 1>::period q = time<int, micro>(2500);
+            static_assert(q.count().count() == 3, "");
+        }
+
+        TEST(PeriodicScheduler, RunsTasksInDeadlineOrder) {
+            trace.clear();
+            periodic_scheduler<clock, 4, tracer> sched;
+            EXPECT_TRUE(sched.add(30_ms, tracer{ 'c' }, clock::time_point(0)));
+            EXPECT_TRUE(sched.add(10_ms, tracer{ 'a' }, clock::time_point(0)));
+            EXPECT_TRUE(sched.add(20_ms, tracer{ 'b' }, clock::time_point(0)));
+            EXPECT_EQ(10, sched.next_deadline().ticks());
+
+            EXPECT_EQ(0u, sched.dispatch(clock::time_point(9)));
+            for (uint16_t t = 10; t <= 60; t += 10) {
+                sched.dispatch(clock::time_point(t));
+            }
+            // Tasks that are due at the same tick run in the order they were added.
+            EXPECT_EQ("aabcaabacab", trace);
+        }
+
+        TEST(PeriodicScheduler, SkipsMissedPeriods) {
+            trace.clear();
+            periodic_scheduler<clock, 2, tracer> sched;
+            sched.add(10_ms, tracer{ 'a' }, clock::time_point(0));
+
+            EXPECT_EQ(1u, sched.dispatch(clock::time_point(35)));
+            EXPECT_EQ("a", trace);
+            EXPECT_EQ(40, sched.next_deadline().ticks());
+        }
+
+        TEST(PeriodicScheduler, WrapsWithTheCounter) {
+            trace.clear();
+            periodic_scheduler<clock, 2, tracer> sched;
+            sched.add(100_ms, tracer{ 'a' }, clock::time_point(65500));
+            sched.add(1_s, tracer{ 'b' }, clock::time_point(65500));
+
+            EXPECT_EQ(0u, sched.dispatch(clock::time_point(65535)));
+            EXPECT_EQ(1u, sched.dispatch(clock::time_point(64)));
+            EXPECT_EQ(164, sched.next_deadline().ticks());
+            EXPECT_EQ("a", trace);
+        }
+
+        TEST(PeriodicScheduler, Full) {
+            periodic_scheduler<clock, 1> sched;
+            EXPECT_TRUE(sched.add(1_ms, [] {}, clock::time_point(0)));
+            EXPECT_FALSE(sched.add(1_ms, [] {}, clock::time_point(0)));
+            EXPECT_EQ(1u, sched.task_count());
+        }
+
+        TEST(PeriodicScheduler, UsesTheClock) {
+            trace.clear();
+            sim_timer::value = 5;
+            periodic_scheduler<clock, 1, tracer> sched;
+            sched.add(10_ms, tracer{ 'a' });
+            sim_timer::value = 15;
+            EXPECT_EQ(1u, sched.dispatch());
+        }
+    }
+}
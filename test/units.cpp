@@ -103,6 +103,26 @@ namespace ctd {
             EXPECT_EQ("10 m*kg/s^2", output);
         }
 
+        TEST(QuantityTest, Literals) {
+#if defined(CTD_LITERAL_SMALLEST_TYPE)
+            static_assert(is_same_v<voltage<int8_t, milli>, decltype(5_mV)>, "");
+            static_assert(is_same_v<voltage<int16_t, milli>, decltype(128_mV)>, "");
+            static_assert(is_same_v<voltage<int32_t, milli>, decltype(2147483647_mV)>, "");
+            static_assert(is_same_v<voltage<int64_t, milli>, decltype(2147483648_mV)>, "");
+#elif defined(CTD_LITERAL_VALUE_TYPE)
+            static_assert(is_same_v<voltage<CTD_LITERAL_VALUE_TYPE, milli>, decltype(5_mV)>, "");
+#else
+            static_assert(is_same_v<voltage<long, milli>, decltype(5_mV)>, "Literals default to long");
+#endif
+            static_assert((0x1F_mV).count() == 31, "");
+            static_assert((0b101_mV).count() == 5, "");
+            static_assert((017_mV).count() == 15, "");
+            static_assert((1'000'000_uV).count() == 1000000, "");
+            static_assert((0_V).count() == 0, "");
+            EXPECT_EQ(2147483647_mV, 2'147'483'647_mV);
+            EXPECT_EQ(90_min, 1_h + 30_min);
+        }
+
         TEST(QuantityTest, MakeUnity) {
             constexpr auto volts = 123_mV;
             auto unity_volts = make_unity_valued<volts.count()>(volts);
@@ -112,5 +132,97 @@ namespace ctd {
                 "Wrong unit for make unity");
             EXPECT_EQ(volts, unity_volts);
         }
+
+        TEST(QuantityTest, Pow) {
+            auto p = pow<2>(current<int>(3)) * resistance<int>(5);
+            static_assert(is_same_v<units::watt, decltype(p)::units>, "Wrong unit for I^2*R");
+            EXPECT_EQ(45_W, p);
+
+            auto v = pow<3>(length<int, milli>(20));
+            static_assert(is_same_v<units::volume, decltype(v)::units>, "Wrong unit for pow<3>");
+            EXPECT_EQ(8000, v.count());
+            EXPECT_EQ(1, pow<0>(10_m).count());
+        }
+
+        TEST(QuantityTest, SqrtExactScale) {
+            auto side = sqrt(quantity<int, units::area, micro>(250000));
+            static_assert(is_same_v<units::metre, decltype(side)::units>, "Wrong unit for sqrt");
+            EXPECT_EQ(500_mm, side);
+            EXPECT_EQ(500, side.count());
+        }
+
+        TEST(QuantityTest, SqrtInexactScale) {
+            // sqrt(2 * 10^-3 m^2) = 0.0447 m
+            auto side = sqrt(quantity<int, units::area, milli>(2));
+            EXPECT_EQ(4, side.count());
+            static_assert(ratio_equal<ratio<1, 100>, decltype(side)::scale>::value, "Wrong scale for sqrt");
+        }
+
+        TEST(QuantityTest, SqrtFloatingPoint) {
+            auto side = sqrt(quantity<double, units::area, milli>(2));
+            EXPECT_NEAR(0.0447213595, side.count() / 100, 1e-9);
+            constexpr auto c = sqrt(quantity<double, units::area, ratio<1>>(16));
+            static_assert(c.count() == 4, "");
+        }
+
+        TEST(QuantityTest, Rms) {
+            current<int16_t, milli> samples[] = { 100, -100, 100, -100 };
+            decltype(pow<2>(samples[0])) sum = 0;
+            for (auto s : samples) {
+                sum = sum + pow<2>(s);
+            }
+            current<int16_t, milli> rms = sqrt(sum / 4);
+            EXPECT_EQ(100_mA, rms);
+        }
+
+        TEST(QuantityTest, Cbrt) {
+            auto side = cbrt(quantity<int32_t, units::volume, ratio<1, 1000000000>>(8000000));
+            static_assert(is_same_v<units::metre, decltype(side)::units>, "Wrong unit for cbrt");
+            EXPECT_EQ(200_mm, side);
+        }
+
+        TEST(QuantityTest, ApproximateCast) {
+            // A 12 bit ADC with a 3.3 V reference, converted to mV with a multiply and a shift.
+            using counts = voltage<int16_t, ratio<33, 40960>>;
+            using mv = voltage<int16_t, milli>;
+            EXPECT_EQ(3299, (approximate_cast<mv, ratio<0>>(counts(4095))).count());
+            EXPECT_EQ(1650, (approximate_cast<mv, ratio<0>>(counts(2048))).count());
+
+            // 99/98 approximated to 0.1% with either policy.
+            using from = quantity<int32_t, units::unity, ratio<99, 100>>;
+            using to = quantity<int32_t, units::unity, ratio<49, 50>>;
+            for (int32_t x = -10000; x <= 10000; x += 37) {
+                const double exact = x * 99.0 / 98.0;
+                const auto shifted = approximate_cast<to, ratio<1, 1000>>(from(x)).count();
+                const auto simplest = approximate_cast<to, ratio<1, 1000>, approximation_simplest>(from(x)).count();
+                ASSERT_NEAR(exact, shifted, std::abs(exact) * 1e-3 + 0.5) << x;
+                ASSERT_NEAR(exact, simplest, std::abs(exact) * 1e-3 + 0.5) << x;
+            }
+
+            const auto volts = approximate_cast<voltage<double>, ratio<1, 100>>(counts(4096));
+            EXPECT_NEAR(3.3, volts.count(), 0.033);
+        }
+
+        TEST(QuantityTest, FromChrono) {
+            time<int, milli> ms = std::chrono::microseconds(2500);
+            EXPECT_EQ(2, ms.count());
+
+            time<int, milli> from_double = std::chrono::duration<double>(1.5);
+            EXPECT_EQ(1500, from_double.count());
+
+            time<long long, ratio<1, 32768>> ticks = std::chrono::seconds(2);
+            EXPECT_EQ(65536, ticks.count());
+        }
+
+        TEST(QuantityTest, ToChrono) {
+            std::chrono::microseconds us = 5_ms;
+            EXPECT_EQ(5000, us.count());
+
+            std::chrono::duration<double> s = 250_ms;
+            EXPECT_DOUBLE_EQ(0.25, s.count());
+
+            constexpr std::chrono::nanoseconds ns = time<int, ratio<1, 32768>>(1);
+            static_assert(ns.count() == 30517, "");
+        }
     }
 }
\ No newline at end of file